@@ -0,0 +1,132 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "DeltaSyncState.h"
+
+#include <QObject>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QJsonArray>
+#include <QJsonObject>
+
+CDeltaSyncState::CDeltaSyncState( const QString &settingsFileName ) :
+    fFileName( stateFileName( settingsFileName ) )
+{
+}
+
+QString CDeltaSyncState::stateFileName( const QString &settingsFileName )
+{
+    if ( settingsFileName.isEmpty() )
+        return {};
+
+    QFileInfo fi( settingsFileName );
+    return fi.absoluteDir().absoluteFilePath( fi.completeBaseName() + ".deltasync.json" );
+}
+
+bool CDeltaSyncState::load( QString &errorMsg )
+{
+    fWatermarks.clear();
+    fLoaded = false;
+    if ( fFileName.isEmpty() )
+        return false;
+
+    QFile file( fFileName );
+    if ( !file.exists() )   // no previous run, the first run is a full refresh
+    {
+        fLoaded = true;
+        return true;
+    }
+
+    if ( !file.open( QFile::ReadOnly | QFile::Text ) )
+    {
+        errorMsg = QObject::tr( "Could not open file '%1'" ).arg( fFileName );
+        return false;
+    }
+
+    QJsonParseError error;
+    auto json = QJsonDocument::fromJson( file.readAll(), &error );
+    if ( error.error != QJsonParseError::NoError )
+    {
+        errorMsg = QObject::tr( "Could not read file '%1' - '%2' @ %3" ).arg( fFileName ).arg( error.errorString() ).arg( error.offset );
+        return false;
+    }
+
+    auto watermarks = json[ "Watermarks" ].toArray();
+    for ( auto &&ii : watermarks )
+    {
+        auto curr = ii.toObject();
+        SDeltaSyncWatermark watermark;
+        watermark.fWatermark = QDateTime::fromString( curr[ "Watermark" ].toString(), Qt::ISODateWithMs );
+        watermark.fRunsSinceFullRefresh = curr[ "RunsSinceFullRefresh" ].toInt();
+        if ( !watermark.fWatermark.isValid() )
+            continue;
+        fWatermarks[ { curr[ "Server" ].toString(), curr[ "UserID" ].toString() } ] = watermark;
+    }
+    fLoaded = true;
+    return true;
+}
+
+bool CDeltaSyncState::save( QString &errorMsg ) const
+{
+    if ( fFileName.isEmpty() || !fLoaded )
+        return false;
+
+    QJsonArray watermarks;
+    for ( auto &&ii : fWatermarks )
+    {
+        QJsonObject curr;
+        curr[ "Server" ] = ii.first.first;
+        curr[ "UserID" ] = ii.first.second;
+        curr[ "Watermark" ] = ii.second.fWatermark.toUTC().toString( Qt::ISODateWithMs );
+        curr[ "RunsSinceFullRefresh" ] = ii.second.fRunsSinceFullRefresh;
+        watermarks.push_back( curr );
+    }
+
+    QJsonObject root;
+    root[ "Watermarks" ] = watermarks;
+
+    QFile file( fFileName );
+    if ( !file.open( QFile::WriteOnly | QFile::Text | QFile::Truncate ) )
+    {
+        errorMsg = QObject::tr( "Could not open file '%1' for writing" ).arg( fFileName );
+        return false;
+    }
+
+    file.write( QJsonDocument( root ).toJson( QJsonDocument::Indented ) );
+    return true;
+}
+
+SDeltaSyncWatermark CDeltaSyncState::watermark( const QString &serverName, const QString &userID ) const
+{
+    auto pos = fWatermarks.find( { serverName, userID } );
+    if ( pos == fWatermarks.end() )
+        return {};
+    return ( *pos ).second;
+}
+
+void CDeltaSyncState::setWatermark( const QString &serverName, const QString &userID, const SDeltaSyncWatermark &watermark )
+{
+    fWatermarks[ { serverName, userID } ] = watermark;
+}
@@ -0,0 +1,59 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __DELTASYNCSTATE_H
+#define __DELTASYNCSTATE_H
+
+#include <QString>
+#include <QDateTime>
+#include <map>
+#include <utility>
+
+struct SDeltaSyncWatermark
+{
+    QDateTime fWatermark;   // UTC, media whose user data was saved after this is fetched on a delta run
+    int fRunsSinceFullRefresh{ 0 };
+};
+
+// persisted per server/user watermarks for delta syncs, stored next to the settings file.
+// Every sync system of a process shares one, a save writes the watermarks of all of them
+class CDeltaSyncState
+{
+public:
+    CDeltaSyncState( const QString &settingsFileName );
+
+    static QString stateFileName( const QString &settingsFileName );
+    QString fileName() const { return fFileName; }
+
+    bool load( QString &errorMsg );
+    bool isLoaded() const { return fLoaded; }   // a state that failed to load is never saved over the file
+    bool save( QString &errorMsg ) const;
+
+    SDeltaSyncWatermark watermark( const QString &serverName, const QString &userID ) const;
+    void setWatermark( const QString &serverName, const QString &userID, const SDeltaSyncWatermark &watermark );
+
+private:
+    QString fFileName;
+    bool fLoaded{ false };
+    std::map< std::pair< QString, QString >, SDeltaSyncWatermark > fWatermarks;   // ( serverName, userID ) -> watermark
+};
+#endif
@@ -0,0 +1,224 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "EmbyJSON.h"
+
+#include <QDateTime>
+#include <QJsonValue>
+
+namespace
+{
+    constexpr int64_t sMSecsPerDay = 24LL * 60 * 60 * 1000;
+
+    // days between 1970-01-01 and the given proleptic gregorian date
+    int64_t daysFromCivil( int64_t year, int month, int day )
+    {
+        year -= ( month <= 2 ) ? 1 : 0;
+        auto era = ( ( year >= 0 ) ? year : ( year - 399 ) ) / 400;
+        auto yearOfEra = year - ( era * 400 );
+        auto dayOfYear = ( ( 153 * ( month + ( ( month > 2 ) ? -3 : 9 ) ) ) + 2 ) / 5 + day - 1;
+        auto dayOfEra = ( yearOfEra * 365 ) + ( yearOfEra / 4 ) - ( yearOfEra / 100 ) + dayOfYear;
+        return ( era * 146097 ) + dayOfEra - 719468;
+    }
+
+    void civilFromDays( int64_t days, int64_t &year, int &month, int &day )
+    {
+        days += 719468;
+        auto era = ( ( days >= 0 ) ? days : ( days - 146096 ) ) / 146097;
+        auto dayOfEra = days - ( era * 146097 );
+        auto yearOfEra = ( dayOfEra - ( dayOfEra / 1460 ) + ( dayOfEra / 36524 ) - ( dayOfEra / 146096 ) ) / 365;
+        auto dayOfYear = dayOfEra - ( ( 365 * yearOfEra ) + ( yearOfEra / 4 ) - ( yearOfEra / 100 ) );
+        auto monthPos = ( ( 5 * dayOfYear ) + 2 ) / 153;
+        day = static_cast< int >( dayOfYear - ( ( ( 153 * monthPos ) + 2 ) / 5 ) + 1 );
+        month = static_cast< int >( ( monthPos < 10 ) ? ( monthPos + 3 ) : ( monthPos - 9 ) );
+        year = yearOfEra + ( era * 400 ) + ( ( month <= 2 ) ? 1 : 0 );
+    }
+
+    // reads count digits at pos, false if any of them is not a digit
+    bool readDigits( const QChar *data, int pos, int count, int &value )
+    {
+        value = 0;
+        for ( int ii = pos; ii < ( pos + count ); ++ii )
+        {
+            auto digit = data[ ii ].unicode() - '0';
+            if ( ( digit < 0 ) || ( digit > 9 ) )
+                return false;
+            value = ( value * 10 ) + digit;
+        }
+        return true;
+    }
+
+    bool parseDate( const QString &value, int &year, int &month, int &day )
+    {
+        if ( value.length() < 10 )
+            return false;
+
+        auto data = value.constData();
+        if ( ( data[ 4 ] != '-' ) || ( data[ 7 ] != '-' ) )
+            return false;
+        if ( !readDigits( data, 0, 4, year ) || !readDigits( data, 5, 2, month ) || !readDigits( data, 8, 2, day ) )
+            return false;
+        return ( month >= 1 ) && ( month <= 12 ) && ( day >= 1 ) && ( day <= 31 );
+    }
+
+    // only the exact layout Emby writes, false sends the caller to the slow path
+    bool parseEmbyDateTime( const QString &value, int64_t &msecs )
+    {
+        int year, month, day;
+        if ( ( value.length() < 20 ) || !parseDate( value, year, month, day ) )
+            return false;
+
+        auto data = value.constData();
+        if ( ( data[ 10 ] != 'T' ) || ( data[ 13 ] != ':' ) || ( data[ 16 ] != ':' ) )
+            return false;
+
+        int hours, minutes, seconds;
+        if ( !readDigits( data, 11, 2, hours ) || !readDigits( data, 14, 2, minutes ) || !readDigits( data, 17, 2, seconds ) )
+            return false;
+        if ( ( hours > 23 ) || ( minutes > 59 ) || ( seconds > 59 ) )
+            return false;
+
+        int pos = 19;
+        int fraction = 0;
+        if ( data[ pos ] == '.' )
+        {
+            ++pos;
+            int numDigits = 0;
+            for ( ; ( pos < value.length() ) && ( data[ pos ] >= '0' ) && ( data[ pos ] <= '9' ); ++pos, ++numDigits )
+            {
+                if ( numDigits < 3 )
+                    fraction = ( fraction * 10 ) + ( data[ pos ].unicode() - '0' );
+            }
+            if ( numDigits == 0 )
+                return false;
+            for ( ; numDigits < 3; ++numDigits )
+                fraction *= 10;
+        }
+
+        if ( ( pos != ( value.length() - 1 ) ) || ( data[ pos ] != 'Z' ) )
+            return false;
+
+        msecs = ( daysFromCivil( year, month, day ) * sMSecsPerDay ) + ( ( ( ( hours * 60LL ) + minutes ) * 60 + seconds ) * 1000 ) + fraction;
+        return true;
+    }
+}
+
+namespace NEmbyJSON
+{
+    int64_t parseMSecsSinceEpoch( const QString &value )
+    {
+        if ( value.isEmpty() )
+            return sNullMSecs;
+
+        int64_t msecs;
+        if ( parseEmbyDateTime( value, msecs ) )
+            return msecs;
+
+        auto dateTime = QDateTime::fromString( value, Qt::ISODateWithMs );
+        return fromDateTime( dateTime );
+    }
+
+    int64_t toMSecsSinceEpoch( const QJsonValue &value )
+    {
+        if ( !value.isString() )
+            return sNullMSecs;
+        return parseMSecsSinceEpoch( value.toString() );
+    }
+
+    QDateTime toDateTime( int64_t msecs )
+    {
+        if ( msecs == sNullMSecs )
+            return {};
+        return QDateTime::fromMSecsSinceEpoch( msecs, Qt::UTC );
+    }
+
+    QDateTime toDateTime( const QJsonValue &value )
+    {
+        return toDateTime( toMSecsSinceEpoch( value ) );
+    }
+
+    int64_t fromDateTime( const QDateTime &dateTime )
+    {
+        if ( !dateTime.isValid() )
+            return sNullMSecs;
+        return dateTime.toMSecsSinceEpoch();
+    }
+
+    QString toString( int64_t msecs )
+    {
+        if ( msecs == sNullMSecs )
+            return {};
+
+        auto days = msecs / sMSecsPerDay;
+        auto msecsOfDay = msecs % sMSecsPerDay;
+        if ( msecsOfDay < 0 )
+        {
+            msecsOfDay += sMSecsPerDay;
+            --days;
+        }
+
+        int64_t year;
+        int month, day;
+        civilFromDays( days, year, month, day );
+
+        auto secsOfDay = static_cast< int >( msecsOfDay / 1000 );
+        return QString::asprintf( "%04lld-%02d-%02dT%02d:%02d:%02d.%03dZ", static_cast< long long >( year ), month, day, secsOfDay / 3600, ( secsOfDay / 60 ) % 60, secsOfDay % 60, static_cast< int >( msecsOfDay % 1000 ) );
+    }
+
+    QDate toDate( const QJsonValue &value )
+    {
+        if ( !value.isString() )
+            return {};
+
+        auto string = value.toString();
+        int year, month, day;
+        if ( parseDate( string, year, month, day ) )
+            return QDate( year, month, day );
+        return QDate::fromString( string, Qt::ISODate );
+    }
+
+    int64_t toInt64( const QJsonValue &value )
+    {
+        if ( value.isDouble() )
+            return static_cast< int64_t >( value.toDouble() );
+        if ( value.isString() )
+            return value.toString().toLongLong();
+        if ( value.isBool() )
+            return value.toBool() ? 1 : 0;
+        return 0;
+    }
+
+    bool toBool( const QJsonValue &value )
+    {
+        if ( value.isBool() )
+            return value.toBool();
+        if ( value.isDouble() )
+            return value.toDouble() != 0;
+        if ( value.isString() )
+        {
+            // same rules as QVariant's string to bool conversion
+            auto string = value.toString();
+            return !string.isEmpty() && ( string != "0" ) && ( string.compare( "false", Qt::CaseInsensitive ) != 0 );
+        }
+        return false;
+    }
+}
@@ -0,0 +1,53 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __EMBYJSON_H
+#define __EMBYJSON_H
+
+#include <QString>
+
+#include <cstdint>
+#include <limits>
+
+class QDate;
+class QDateTime;
+class QJsonValue;
+
+// Converters for the scalar values in Emby's item json.  Emby writes its dates as
+// yyyy-MM-ddTHH:mm:ss.fffffffZ, that layout is parsed directly and anything else goes through QDateTime
+namespace NEmbyJSON
+{
+    constexpr int64_t sNullMSecs = std::numeric_limits< int64_t >::min();   // no date
+
+    int64_t parseMSecsSinceEpoch( const QString &value );   // sNullMSecs when empty or unparsable
+    int64_t toMSecsSinceEpoch( const QJsonValue &value );
+    QDateTime toDateTime( int64_t msecs );   // UTC, null for sNullMSecs
+    QDateTime toDateTime( const QJsonValue &value );
+    int64_t fromDateTime( const QDateTime &dateTime );
+    QString toString( int64_t msecs );   // yyyy-MM-ddTHH:mm:ss.zzzZ, empty for sNullMSecs
+
+    QDate toDate( const QJsonValue &value );
+    int64_t toInt64( const QJsonValue &value );
+    bool toBool( const QJsonValue &value );
+}
+
+#endif
@@ -0,0 +1,262 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "ItemsStreamReader.h"
+
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QJsonArray>
+
+CItemsStreamReader::CItemsStreamReader( TItemFunc itemFunc ) :
+    fItemFunc( std::move( itemFunc ) )
+{
+}
+
+bool CItemsStreamReader::addData( const QByteArray &data )
+{
+    if ( hasError() )
+        return false;
+
+    fBuffer.append( data );
+    auto size = fBuffer.size();
+    auto buffer = fBuffer.constData();
+    for ( ; fPos < size; ++fPos )
+    {
+        auto ch = buffer[ fPos ];
+        if ( fInString )
+        {
+            if ( fEscape )
+                fEscape = false;
+            else if ( ch == '\\' )
+                fEscape = true;
+            else if ( ch == '"' )
+            {
+                fInString = false;
+                if ( fState == EState::eKey )
+                {
+                    // let the JSON parser decode the key so escapes are handled
+                    auto key = QJsonDocument::fromJson( "[" + fBuffer.mid( fTokenStart, fPos - fTokenStart + 1 ) + "]" ).array();
+                    fKey = key.isEmpty() ? QString() : key[ 0 ].toString();
+                    fTokenStart = -1;
+                    fState = EState::eColon;
+                }
+            }
+            continue;
+        }
+
+        if ( ( ch == ' ' ) || ( ch == '\t' ) || ( ch == '\r' ) || ( ch == '\n' ) )
+            continue;
+
+        switch ( fState )
+        {
+            case EState::eStart:
+                if ( ch != '{' )
+                {
+                    setError( "expected an object", fConsumed + fPos );
+                    return false;
+                }
+                fState = EState::eKeyOrEnd;
+                break;
+            case EState::eKeyOrEnd:
+                if ( ch == '}' )
+                {
+                    fState = EState::eDone;
+                    break;
+                }
+                if ( ch != '"' )
+                {
+                    setError( "expected a key", fConsumed + fPos );
+                    return false;
+                }
+                fTokenStart = fPos;
+                fInString = true;
+                fState = EState::eKey;
+                break;
+            case EState::eKey:   // keys end in the string handling above
+                break;
+            case EState::eColon:
+                if ( ch != ':' )
+                {
+                    setError( "expected ':'", fConsumed + fPos );
+                    return false;
+                }
+                fState = EState::eValueStart;
+                break;
+            case EState::eValueStart:
+                if ( ( fKey == "Items" ) && ( ch == '[' ) )
+                {
+                    fIsItemList = true;
+                    fState = EState::eItemOrEnd;
+                    break;
+                }
+                fTokenStart = fPos;
+                fDepth = 0;
+                fState = EState::eValue;
+                [[fallthrough]];
+            case EState::eValue:
+                if ( ch == '"' )
+                    fInString = true;
+                else if ( ( ch == '{' ) || ( ch == '[' ) )
+                    fDepth++;
+                else if ( ( ch == '}' ) || ( ch == ']' ) )
+                {
+                    if ( fDepth > 0 )
+                        fDepth--;
+                    else   // the end of the response
+                    {
+                        if ( ( ch != '}' ) || !finishValue( fPos ) )
+                        {
+                            if ( !hasError() )
+                                setError( "expected '}'", fConsumed + fPos );
+                            return false;
+                        }
+                        fState = EState::eDone;
+                    }
+                }
+                else if ( ( ch == ',' ) && ( fDepth == 0 ) )
+                {
+                    if ( !finishValue( fPos ) )
+                        return false;
+                    fState = EState::eKeyOrEnd;
+                }
+                break;
+            case EState::eItemOrEnd:
+                if ( ch == ']' )
+                {
+                    fState = EState::eAfterValue;
+                    break;
+                }
+                if ( ch != '{' )
+                {
+                    setError( "expected an item", fConsumed + fPos );
+                    return false;
+                }
+                fTokenStart = fPos;
+                fDepth = 1;
+                fState = EState::eItem;
+                break;
+            case EState::eItem:
+                if ( ch == '"' )
+                    fInString = true;
+                else if ( ( ch == '{' ) || ( ch == '[' ) )
+                    fDepth++;
+                else if ( ( ch == '}' ) || ( ch == ']' ) )
+                {
+                    if ( --fDepth == 0 )
+                    {
+                        if ( !finishItem( fPos + 1 ) )
+                            return false;
+                        fState = EState::eAfterItem;
+                    }
+                }
+                break;
+            case EState::eAfterItem:
+                if ( ch == ',' )
+                    fState = EState::eItemOrEnd;
+                else if ( ch == ']' )
+                    fState = EState::eAfterValue;
+                else
+                {
+                    setError( "expected ',' or ']'", fConsumed + fPos );
+                    return false;
+                }
+                break;
+            case EState::eAfterValue:
+                if ( ch == ',' )
+                    fState = EState::eKeyOrEnd;
+                else if ( ch == '}' )
+                    fState = EState::eDone;
+                else
+                {
+                    setError( "expected ',' or '}'", fConsumed + fPos );
+                    return false;
+                }
+                break;
+            case EState::eDone:
+                setError( "unexpected data after the response", fConsumed + fPos );
+                return false;
+        }
+    }
+
+    // only the key, value or item being read is kept
+    auto keepFrom = ( fTokenStart >= 0 ) ? fTokenStart : fPos;
+    if ( keepFrom > 0 )
+    {
+        fBuffer.remove( 0, keepFrom );
+        fConsumed += keepFrom;
+        fPos -= keepFrom;
+        if ( fTokenStart >= 0 )
+            fTokenStart -= keepFrom;
+    }
+    return true;
+}
+
+bool CItemsStreamReader::finish()
+{
+    if ( hasError() )
+        return false;
+
+    if ( fInString || ( fState != EState::eDone ) )
+    {
+        setError( "unexpected end of data", fConsumed + fPos );
+        return false;
+    }
+    return true;
+}
+
+void CItemsStreamReader::setError( const QString &msg, qint64 offset )
+{
+    fErrorMsg = QString( "%1 @ %2" ).arg( msg ).arg( offset );
+}
+
+bool CItemsStreamReader::finishValue( int end )
+{
+    // wrapped in an array so scalars parse as well
+    QJsonParseError error;
+    auto value = QJsonDocument::fromJson( "[" + fBuffer.mid( fTokenStart, end - fTokenStart ) + "]", &error );
+    if ( error.error != QJsonParseError::NoError )
+    {
+        setError( error.errorString(), fConsumed + fTokenStart + error.offset - 1 );
+        return false;
+    }
+
+    fHeader[ fKey ] = value.array()[ 0 ];
+    fTokenStart = -1;
+    return true;
+}
+
+bool CItemsStreamReader::finishItem( int end )
+{
+    QJsonParseError error;
+    auto item = QJsonDocument::fromJson( QByteArray::fromRawData( fBuffer.constData() + fTokenStart, end - fTokenStart ), &error );
+    if ( error.error != QJsonParseError::NoError )
+    {
+        setError( error.errorString(), fConsumed + fTokenStart + error.offset );
+        return false;
+    }
+
+    fTokenStart = -1;
+    fItemCount++;
+    if ( fItemFunc )
+        fItemFunc( item.object() );
+    return true;
+}
@@ -0,0 +1,91 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __ITEMSSTREAMREADER_H
+#define __ITEMSSTREAMREADER_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+
+#include <functional>
+
+// Incremental reader for Items responses ( { "Items": [ ... ], "TotalRecordCount": N } ).
+// Data is added as it arrives and each entry of the Items array is handed to the item
+// function as soon as its closing brace is seen.  Only the entry being read is buffered,
+// so memory does not grow with the size of the library.  The other top level members are
+// collected in the header.  A response that is not an Items list ends up entirely in the header.
+class CItemsStreamReader
+{
+public:
+    using TItemFunc = std::function< void( const QJsonObject &item ) >;
+
+    CItemsStreamReader( TItemFunc itemFunc );
+
+    bool addData( const QByteArray &data );   // returns false once the data is invalid
+    bool finish();   // returns false if the data was invalid or incomplete
+
+    bool hasError() const { return !fErrorMsg.isEmpty(); }
+    QString errorString() const { return fErrorMsg; }
+
+    const QJsonObject &header() const { return fHeader; }
+    bool isItemList() const { return fIsItemList; }
+    int itemCount() const { return fItemCount; }
+
+private:
+    enum class EState
+    {
+        eStart,
+        eKeyOrEnd,
+        eKey,
+        eColon,
+        eValueStart,
+        eValue,
+        eAfterValue,
+        eItemOrEnd,
+        eItem,
+        eAfterItem,
+        eDone
+    };
+
+    void setError( const QString &msg, qint64 offset );
+    bool finishValue( int end );
+    bool finishItem( int end );
+
+    TItemFunc fItemFunc;
+    QByteArray fBuffer;   // the unconsumed data, starts at the value or item being read
+    int fPos{ 0 };   // next byte to scan in fBuffer
+    qint64 fConsumed{ 0 };   // bytes dropped from the front of fBuffer, for error offsets
+    int fTokenStart{ -1 };   // start of the key, value or item being read
+
+    EState fState{ EState::eStart };
+    int fDepth{ 0 };   // nesting inside the current value or item
+    bool fInString{ false };
+    bool fEscape{ false };
+    QString fKey;
+
+    QJsonObject fHeader;
+    bool fIsItemList{ false };
+    int fItemCount{ 0 };
+    QString fErrorMsg;
+};
+#endif
@@ -0,0 +1,75 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __MEDIACATALOG_H
+#define __MEDIACATALOG_H
+
+#include "MediaData.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// Owns the media records of one load generation.  The records live in fixed size blocks so their
+// addresses never move, and are addressed by a 32 bit handle.  Shared pointers handed out to the
+// rest of the system alias the generation, so no record needs its own allocation or control block,
+// and the whole generation is released at once when the last reference to it goes away
+class CMediaCatalog
+{
+public:
+    using THandle = uint32_t;
+    static constexpr THandle sInvalidHandle = std::numeric_limits< THandle >::max();
+
+    CMediaCatalog();
+
+    template< typename... TArgs >
+    THandle create( TArgs &&...args )
+    {
+        auto &&blocks = fArena->fBlocks;
+        if ( blocks.empty() || ( blocks.back().size() == blocks.back().capacity() ) )
+        {
+            blocks.emplace_back();
+            blocks.back().reserve( sBlockSize );
+        }
+        blocks.back().emplace_back( std::forward< TArgs >( args )... );
+        return fCount++;
+    }
+
+    CMediaData *get( THandle handle ) const;
+    std::shared_ptr< CMediaData > shared( THandle handle ) const;
+
+    size_t size() const { return fCount; }
+    void clear();   // starts a new generation, the old one is freed once no one references it
+
+private:
+    struct SArena
+    {
+        std::vector< std::vector< CMediaData > > fBlocks;   // never grown past sBlockSize, so the records do not move
+    };
+    static constexpr size_t sBlockSize = 4096;
+
+    std::shared_ptr< SArena > fArena;
+    THandle fCount{ 0 };
+};
+
+#endif
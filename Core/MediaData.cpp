@@ -60,17 +60,19 @@ std::function< QString( uint64_t ) > CMediaData::mecsToStringFunc()
     return sMSecsToStringFunc;
 }
 
-CMediaData::CMediaData( const QJsonObject &mediaObj, std::shared_ptr< CServerModel > serverModel )
+CMediaData::CMediaData( const QJsonObject &mediaObj, std::shared_ptr< CServerModel > serverModel ) :
+    fServerModel( serverModel )
 {
     computeName( mediaObj );
-    fType = mediaObj[ "Type" ].toString();
+    fType = CSymbol( mediaObj[ "Type" ].toString() );
     fOriginalTitle = mediaObj[ "OriginalTitle" ].toString();
 
-    for ( auto &&serverInfo : *serverModel )
+    fInfoForServer.resize( serverModel->serverCnt() );
+    for ( int ii = 0; ii < serverModel->serverCnt(); ++ii )
     {
-        if ( !serverInfo->isEnabled() )
+        if ( !serverModel->getServerInfo( ii )->isEnabled() )
             continue;
-        fInfoForServer[ serverInfo->keyName() ] = std::make_shared< SMediaServerData >();
+        fInfoForServer[ ii ].emplace();
     }
 }
 
@@ -78,7 +80,7 @@ CMediaData::CMediaData( const SMovieStub &movieStub, const QString &type )
 {
     fName = movieStub.fName;
     fOriginalTitle = fName;
-    fType = type;
+    fType = CSymbol( type );
     fPremiereDate = QDate( movieStub.fYear, 1, 1 );
     if ( movieStub.hasResolution() )
         fResolution = movieStub.fResolution.value();
@@ -133,12 +135,33 @@ bool CMediaData::isExtra( const QJsonObject &obj )
     return false;
 }
 
+int CMediaData::serverNum( const QString &serverName ) const
+{
+    if ( !fServerModel )
+        return -1;
+    return fServerModel->getServerPos( serverName );
+}
+
+const SMediaServerData *CMediaData::serverData( int serverNum ) const
+{
+    if ( ( serverNum < 0 ) || ( serverNum >= static_cast< int >( fInfoForServer.size() ) ) || !fInfoForServer[ serverNum ].has_value() || fInfoForServer[ serverNum ]->fHidden )
+        return nullptr;
+    return &fInfoForServer[ serverNum ].value();
+}
+
+SMediaServerData *CMediaData::mutableServerData( int serverNum )
+{
+    if ( ( serverNum < 0 ) || ( serverNum >= static_cast< int >( fInfoForServer.size() ) ) || !fInfoForServer[ serverNum ].has_value() )
+        return nullptr;
+    return &fInfoForServer[ serverNum ].value();
+}
+
 std::shared_ptr< SMediaServerData > CMediaData::userMediaData( const QString &serverName ) const
 {
-    auto pos = fInfoForServer.find( serverName );
-    if ( pos != fInfoForServer.end() )
-        return ( *pos ).second;
-    return {};
+    auto mediaData = serverData( serverNum( serverName ) );
+    if ( !mediaData )
+        return {};
+    return std::make_shared< SMediaServerData >( *mediaData );
 }
 
 QString CMediaData::name() const
@@ -148,12 +171,12 @@ QString CMediaData::name() const
 
 QString CMediaData::seriesName() const
 {
-    return fSeriesName;
+    return fSeriesName.toString();
 }
 
 QString CMediaData::mediaType() const
 {
-    return fType;
+    return fType.toString();
 }
 
 void CMediaData::computeName( const QJsonObject &media )
@@ -164,7 +187,7 @@ void CMediaData::computeName( const QJsonObject &media )
         // auto tmp = QJsonDocument( media );
         // qDebug() << tmp.toJson();
 
-        fSeriesName = media[ "SeriesName" ].toString();
+        fSeriesName = CSymbol( media[ "SeriesName" ].toString() );
         auto season = media[ "SeasonName" ].toString();
         auto pos = season.lastIndexOf( ' ' );
         bool aOK = false;
@@ -185,7 +208,7 @@ void CMediaData::computeName( const QJsonObject &media )
             fEpisode.reset();
 
         auto episode = fEpisode.has_value() ? QString( "E%1" ).arg( fEpisode.value(), 2, 10, QChar( '0' ) ) : QString();
-        fName = QString( "%1 - %2%3" ).arg( fSeriesName ).arg( season ).arg( episode );
+        fName = QString( "%1 - %2%3" ).arg( fSeriesName.toString() ).arg( season ).arg( episode );
         auto episodeName = media[ "EpisodeTitle" ].toString();
         if ( !episodeName.isEmpty() )
             fName += QString( " - %1" ).arg( episodeName );
@@ -212,8 +235,10 @@ void CMediaData::loadData( const QString &serverName, const QJsonObject &media )
     // auto tmp = QJsonDocument( userDataObj );
     // qDebug() << tmp.toJson();
 
-    auto mediaData = userMediaData( serverName );
-    mediaData->loadUserDataFromJSON( userDataObj );
+    auto mediaData = mutableServerData( serverNum( serverName ) );
+    if ( mediaData )
+        mediaData->loadUserDataFromJSON( userDataObj );
+    updateSyncState();
 
     auto providerIDsObj = media[ "ProviderIds" ].toObject();
     for ( auto &&ii = providerIDsObj.begin(); ii != providerIDsObj.end(); ++ii )
@@ -223,13 +248,40 @@ void CMediaData::loadData( const QString &serverName, const QJsonObject &media )
         addProvider( providerName, providerID );
     }
 
-    fPremiereDate = media[ "PremiereDate" ].toVariant().toDate();
+    fPremiereDate = NEmbyJSON::toDate( media[ "PremiereDate" ] );
     if ( media.contains( "MediaSources" ) )
     {
         loadResolution( media[ "MediaSources" ].toArray() );
     }
 }
 
+void CMediaData::loadUserData( const QString &serverName, const QJsonObject &userDataObj )
+{
+    auto mediaData = mutableServerData( serverNum( serverName ) );
+    if ( !mediaData )
+        return;
+    mediaData->loadUserDataFromJSON( userDataObj );
+    updateSyncState();
+}
+
+void CMediaData::clearUserData( const QString &serverName )
+{
+    auto mediaData = mutableServerData( serverNum( serverName ) );
+    if ( !mediaData )
+        return;
+    mediaData->clearUserData();
+    updateSyncState();
+}
+
+void CMediaData::hideFromUser( const QString &serverName )
+{
+    auto mediaData = mutableServerData( serverNum( serverName ) );
+    if ( !mediaData )
+        return;
+    mediaData->hide();
+    updateSyncState();
+}
+
 void CMediaData::loadResolution( const QJsonArray &mediaSources )
 {
     //qDebug().noquote().nospace() << QJsonDocument( mediaSources ).toJson( QJsonDocument::Indented );
@@ -278,7 +330,7 @@ bool CMediaData::hasProviderIDs() const
 QString CMediaData::getProviderList() const
 {
     QStringList retVal;
-    for ( auto &&ii : fProviders )
+    for ( auto &&ii : getProviders() )
     {
         retVal << ii.first.toLower() + "." + ii.second.toLower();
     }
@@ -287,7 +339,12 @@ QString CMediaData::getProviderList() const
 
 bool CMediaData::isPlayed( const QString &serverName ) const
 {
-    auto mediaData = userMediaData( serverName );
+    return isPlayed( serverNum( serverName ) );
+}
+
+bool CMediaData::isPlayed( int serverNum ) const
+{
+    auto mediaData = serverData( serverNum );
     if ( !mediaData )
         return false;
     return mediaData->fPlayed;
@@ -295,7 +352,12 @@ bool CMediaData::isPlayed( const QString &serverName ) const
 
 uint64_t CMediaData::playCount( const QString &serverName ) const
 {
-    auto mediaData = userMediaData( serverName );
+    return playCount( serverNum( serverName ) );
+}
+
+uint64_t CMediaData::playCount( int serverNum ) const
+{
+    auto mediaData = serverData( serverNum );
     if ( !mediaData )
         return 0;
     return mediaData->fPlayCount;
@@ -303,12 +365,17 @@ uint64_t CMediaData::playCount( const QString &serverName ) const
 
 bool CMediaData::allPlayCountEqual() const
 {
-    return allEqual< uint64_t >( []( std::shared_ptr< SMediaServerData > data ) { return data->fPlayCount; } );
+    return !userDataDiffers( EUserDataField::ePlayCount );
 }
 
 bool CMediaData::isFavorite( const QString &serverName ) const
 {
-    auto mediaData = userMediaData( serverName );
+    return isFavorite( serverNum( serverName ) );
+}
+
+bool CMediaData::isFavorite( int serverNum ) const
+{
+    auto mediaData = serverData( serverNum );
     if ( !mediaData )
         return false;
     return mediaData->fIsFavorite;
@@ -316,26 +383,31 @@ bool CMediaData::isFavorite( const QString &serverName ) const
 
 bool CMediaData::allFavoriteEqual() const
 {
-    return allEqual< bool >( []( std::shared_ptr< SMediaServerData > data ) { return data->fIsFavorite; } );
+    return !userDataDiffers( EUserDataField::eFavorite );
 }
 
 QDateTime CMediaData::lastPlayed( const QString &serverName ) const
 {
-    auto mediaData = userMediaData( serverName );
+    return lastPlayed( serverNum( serverName ) );
+}
+
+QDateTime CMediaData::lastPlayed( int serverNum ) const
+{
+    auto mediaData = serverData( serverNum );
     if ( !mediaData )
         return {};
-    return mediaData->fLastPlayedDate;
+    return mediaData->lastPlayedDate();
 }
 
 bool CMediaData::allLastPlayedEqual() const
 {
-    return allEqual< QDateTime >( []( std::shared_ptr< SMediaServerData > data ) { return data->fLastPlayedDate; } );
+    return !userDataDiffers( EUserDataField::eLastPlayed );
 }
 
 // 1 tick = 10000 ms
 uint64_t CMediaData::playbackPositionTicks( const QString &serverName ) const
 {
-    auto mediaData = userMediaData( serverName );
+    auto mediaData = serverData( serverNum( serverName ) );
     if ( !mediaData )
         return 0;
     return mediaData->fPlaybackPositionTicks;
@@ -345,7 +417,7 @@ uint64_t CMediaData::playbackPositionTicks( const QString &serverName ) const
 // 1 tick = 10000 ms
 uint64_t CMediaData::playbackPositionMSecs( const QString &serverName ) const
 {
-    auto mediaData = userMediaData( serverName );
+    auto mediaData = serverData( serverNum( serverName ) );
     if ( !mediaData )
         return 0;
     return mediaData->playbackPositionMSecs();
@@ -353,7 +425,12 @@ uint64_t CMediaData::playbackPositionMSecs( const QString &serverName ) const
 
 QString CMediaData::playbackPosition( const QString &serverName ) const
 {
-    auto mediaData = userMediaData( serverName );
+    return playbackPosition( serverNum( serverName ) );
+}
+
+QString CMediaData::playbackPosition( int serverNum ) const
+{
+    auto mediaData = serverData( serverNum );
     if ( !mediaData )
         return {};
     return mediaData->playbackPosition();
@@ -361,7 +438,7 @@ QString CMediaData::playbackPosition( const QString &serverName ) const
 
 QTime CMediaData::playbackPositionTime( const QString &serverName ) const
 {
-    auto mediaData = userMediaData( serverName );
+    auto mediaData = serverData( serverNum( serverName ) );
     if ( !mediaData )
         return {};
     return mediaData->playbackPositionTime();
@@ -381,12 +458,12 @@ std::pair< int, int > CMediaData::resolutionValue() const
 
 bool CMediaData::allPlayedEqual() const
 {
-    return allEqual< bool >( []( std::shared_ptr< SMediaServerData > data ) { return data->fPlayed; } );
+    return !userDataDiffers( EUserDataField::ePlayed );
 }
 
 bool CMediaData::allPlaybackPositionTicksEqual() const
 {
-    return allEqual< int64_t >( []( std::shared_ptr< SMediaServerData > data ) { return data->fPlaybackPositionTicks; } );
+    return !userDataDiffers( EUserDataField::ePlaybackPosition );
 }
 
 QUrlQuery CMediaData::getSearchForMediaQuery() const
@@ -404,76 +481,123 @@ QUrlQuery CMediaData::getSearchForMediaQuery() const
 
 QString CMediaData::getProviderID( const QString &provider )
 {
-    auto pos = fProviders.find( provider );
-    if ( pos == fProviders.end() )
-        return {};
-    return ( *pos ).second;
+    return getProviderID( CSymbol( provider ) );
 }
 
-std::map< QString, QString > CMediaData::getProviders( bool addKeyIfEmpty /*= false */ ) const
+QString CMediaData::getProviderID( const CSymbol &provider ) const
 {
-    auto retVal = fProviders;
-    if ( addKeyIfEmpty && retVal.empty() )
-    {
-        retVal[ fType ] = fName;
-    }
+    return fProviders.get( provider );
+}
 
-    return std::move( retVal );
+std::map< QString, QString > CMediaData::getProviders( bool addKeyIfEmpty /*= false */ ) const
+{
+    std::map< QString, QString > retVal;
+    forEachProvider( addKeyIfEmpty, [ &retVal ]( const CSymbol &providerName, const QString &providerID ) { retVal[ providerName.toString() ] = providerID; } );
+    return retVal;
 }
 
 void CMediaData::addProvider( const QString &providerName, const QString &providerID )
 {
-    fProviders[ providerName ] = providerID;
+    fProviders.set( CSymbol( providerName ), providerID );
 }
 
 void CMediaData::setMediaID( const QString &serverName, const QString &mediaID )
 {
-    auto mediaData = userMediaData( serverName );
+    auto mediaData = mutableServerData( serverNum( serverName ) );
+    if ( !mediaData )
+        return;
     mediaData->fMediaID = mediaID;
-    updateCanBeSynced();
+    updateSyncState();
 }
 
-void CMediaData::updateCanBeSynced()
+void CMediaData::updateSyncState()
 {
     int serverCnt = 0;
-    for ( auto &&ii : fInfoForServer )
+    fUserDataEqual = true;
+    fUserDataDiffs = 0;
+    fNewestServer = -1;
+
+    const SMediaServerData *first = nullptr;
+    const SMediaServerData *prev = nullptr;
+    for ( int ii = 0; ii < static_cast< int >( fInfoForServer.size() ); ++ii )
     {
-        if ( ii.second->isValid() )
-            serverCnt++;
+        auto curr = serverData( ii );
+        if ( !curr || !curr->isValid() )
+            continue;
+
+        serverCnt++;
+        if ( !first )
+            first = curr;
+        else
+        {
+            if ( curr->fPlayed != first->fPlayed )
+                fUserDataDiffs |= static_cast< uint8_t >( EUserDataField::ePlayed );
+            if ( curr->fIsFavorite != first->fIsFavorite )
+                fUserDataDiffs |= static_cast< uint8_t >( EUserDataField::eFavorite );
+            if ( curr->fLastPlayedMSecs != first->fLastPlayedMSecs )
+                fUserDataDiffs |= static_cast< uint8_t >( EUserDataField::eLastPlayed );
+            if ( curr->fPlayCount != first->fPlayCount )
+                fUserDataDiffs |= static_cast< uint8_t >( EUserDataField::ePlayCount );
+            if ( curr->fPlaybackPositionTicks != first->fPlaybackPositionTicks )
+                fUserDataDiffs |= static_cast< uint8_t >( EUserDataField::ePlaybackPosition );
+        }
+
+        // userDataEqual ignores a missing last played date, so it is tracked separately from the field differences
+        if ( prev && !prev->userDataEqual( *curr ) )
+            fUserDataEqual = false;
+        prev = curr;
+
+        if ( ( fNewestServer == -1 ) || ( curr->fLastPlayedMSecs > fInfoForServer[ fNewestServer ]->fLastPlayedMSecs ) )
+            fNewestServer = ii;
     }
     fCanBeSynced = serverCnt > 1;
 }
 
+bool CMediaData::userDataDiffers( EUserDataField field ) const
+{
+    return ( fUserDataDiffs & static_cast< uint8_t >( field ) ) != 0;
+}
+
 QString CMediaData::getMediaID( const QString &serverName ) const
 {
-    auto mediaData = userMediaData( serverName );
-    if ( !mediaData )
+    return getMediaID( serverNum( serverName ) );
+}
+
+QString CMediaData::getMediaID( int serverNum ) const
+{
+    // hidden entries keep their ID, the indexes and reloads still need it
+    if ( ( serverNum < 0 ) || ( serverNum >= static_cast< int >( fInfoForServer.size() ) ) || !fInfoForServer[ serverNum ].has_value() )
         return {};
-    return mediaData->fMediaID;
+    return fInfoForServer[ serverNum ]->fMediaID;
 }
 
 bool CMediaData::beenLoaded( const QString &serverName ) const
 {
-    auto mediaData = userMediaData( serverName );
+    auto mediaData = serverData( serverNum( serverName ) );
     if ( !mediaData )
         return {};
     return mediaData->fBeenLoaded;
 }
 
 QIcon CMediaData::getDirectionIcon( const QString &serverName ) const
+{
+    return getDirectionIcon( serverNum( serverName ) );
+}
+
+QIcon CMediaData::getDirectionIcon( int serverNum ) const
 {
     static QIcon sErrorIcon( ":/resources/error.png" );
     static QIcon sEqualIcon( ":/resources/equal.png" );
     static QIcon sArrowUpIcon( ":/resources/arrowup.png" );
     static QIcon sArrowDownIcon( ":/resources/arrowdown.png" );
     QIcon retVal;
-    if ( !isValidForServer( serverName ) )
+    if ( !isValidForServer( serverNum ) )
         retVal = sErrorIcon;
     else if ( !canBeSynced() )
         return {};
     else if ( validUserDataEqual() )
         retVal = sEqualIcon;
-    else if ( needsUpdating( serverName ) )
+    else if ( needsUpdating( serverNum ) )
         retVal = sArrowDownIcon;
     else
         retVal = sArrowUpIcon;
@@ -496,17 +620,14 @@ QUrl CMediaData::getSearchURL( ESearchSite site ) const
     QUrl retVal( url );
     QString searchKey;
 
-    auto pos = fProviders.find( "imdb" );
-    if ( pos != fProviders.end() )
-    {
-        searchKey = ( *pos ).second;
-    }
+    static const CSymbol sIMDBProvider( "imdb" );
+    searchKey = fProviders.get( sIMDBProvider );
     if ( searchKey.isEmpty() )
         searchKey = QString( R"("%1")" ).arg( fName );
 
     if ( this->mediaType() == "Episode" )
     {
-        searchKey = fSeriesName;
+        searchKey = fSeriesName.toString();
         searchKey = searchKey.replace( R"((US))", "" ).trimmed();
 
         QString subKey;
@@ -541,10 +662,10 @@ QJsonObject CMediaData::toJson( bool includeSearchURL ) const
 {
     QJsonObject retVal;
 
-    retVal[ "type" ] = fType;
+    retVal[ "type" ] = fType.toString();
     retVal[ "name" ] = fName;
     if ( !fSeriesName.isEmpty() )
-        retVal[ "seriesname" ] = fSeriesName;
+        retVal[ "seriesname" ] = fSeriesName.toString();
     if ( fSeason.has_value() )
         retVal[ "season" ] = fSeason.value();
     if ( fEpisode.has_value() )
@@ -552,13 +673,14 @@ QJsonObject CMediaData::toJson( bool includeSearchURL ) const
     retVal[ "premiere_date" ] = fPremiereDate.toString( "MM/dd/yyyy" );
 
     QJsonArray serverInfos;
-    for ( auto &&ii : fInfoForServer )
+    for ( int ii = 0; ii < static_cast< int >( fInfoForServer.size() ); ++ii )
     {
-        if ( !ii.second->isValid() )
+        auto mediaData = serverData( ii );
+        if ( !mediaData || !mediaData->isValid() )
             continue;
-        ;
-        auto serverInfo = ii.second->toJson();
-        serverInfo[ "server_url" ] = ii.first;
+
+        auto serverInfo = mediaData->toJson();
+        serverInfo[ "server_url" ] = fServerModel->getServerInfo( ii )->keyName();
         serverInfos.push_back( serverInfo );
     }
     retVal[ "server_infos" ] = serverInfos;
@@ -571,51 +693,66 @@ QJsonObject CMediaData::toJson( bool includeSearchURL ) const
 
 bool CMediaData::onServer() const
 {
-    return !this->fInfoForServer.empty();
+    for ( auto &&ii : fInfoForServer )
+    {
+        if ( ii.has_value() )
+            return true;
+    }
+    return false;
 }
 
-void CMediaData::updateFromOther( const QString &otherServerName, std::shared_ptr< CMediaData > other )
+void CMediaData::updateFromOther( const QString &otherServerName, const std::shared_ptr< CMediaData > &other )
 {
-    auto otherMediaData = other->userMediaData( otherServerName );
+    updateFromOther( serverNum( otherServerName ), other );
+}
+
+void CMediaData::updateFromOther( int otherServerNum, const std::shared_ptr< CMediaData > &other )
+{
+    auto otherMediaData = other->serverData( otherServerNum );
     if ( !otherMediaData )
         return;
 
-    fInfoForServer[ otherServerName ] = otherMediaData;
-    updateCanBeSynced();
+    if ( otherServerNum >= static_cast< int >( fInfoForServer.size() ) )
+        fInfoForServer.resize( otherServerNum + 1 );
+    fInfoForServer[ otherServerNum ] = *otherMediaData;
+    updateSyncState();
 }
 
 bool CMediaData::needsUpdating( const QString &serverName ) const
+{
+    return needsUpdating( serverNum( serverName ) );
+}
+
+bool CMediaData::needsUpdating( int serverNum ) const
 {
     // TODO: When Emby supports last modified use that
 
-    auto mediaData = userMediaData( serverName );
-    if ( !mediaData )
+    if ( !serverData( serverNum ) )
         return false;
-    return ( mediaData != newestMediaData() );
+    return ( serverNum != newestServer() );
 }
 
-std::shared_ptr< SMediaServerData > CMediaData::newestMediaData() const
+int CMediaData::newestServer() const
 {
-    std::shared_ptr< SMediaServerData > retVal;
-    for ( auto &&ii : fInfoForServer )
-    {
-        if ( !ii.second->isValid() )
-            continue;
+    return fNewestServer;
+}
 
-        if ( !retVal )
-            retVal = ii.second;
-        else
-        {
-            if ( ii.second->fLastPlayedDate > retVal->fLastPlayedDate )
-                retVal = ii.second;
-        }
-    }
-    return retVal;
+std::shared_ptr< SMediaServerData > CMediaData::newestMediaData() const
+{
+    auto mediaData = serverData( newestServer() );
+    if ( !mediaData )
+        return {};
+    return std::make_shared< SMediaServerData >( *mediaData );
 }
 
 bool CMediaData::isValidForServer( const QString &serverName ) const
 {
-    auto mediaInfo = userMediaData( serverName );
+    return isValidForServer( serverNum( serverName ) );
+}
+
+bool CMediaData::isValidForServer( int serverNum ) const
+{
+    auto mediaInfo = serverData( serverNum );
     if ( !mediaInfo )
         return false;
     return mediaInfo->isValid();
@@ -625,7 +762,7 @@ bool CMediaData::isValidForAllServers() const
 {
     for ( auto &&ii : fInfoForServer )
     {
-        if ( !ii.second->isValid() )
+        if ( ii.has_value() && !ii->isValid() )
             return false;
     }
     return true;
@@ -648,22 +785,7 @@ EMediaSyncStatus CMediaData::syncStatus() const
 
 bool CMediaData::validUserDataEqual() const
 {
-    std::list< std::pair< QString, std::shared_ptr< SMediaServerData > > > validServerData;
-    for ( auto &&ii : fInfoForServer )
-    {
-        if ( ii.second->isValid() )
-            validServerData.push_back( ii );
-    }
-
-    auto pos = validServerData.begin();
-    auto nextPos = validServerData.begin();
-    nextPos++;
-    for ( ; ( pos != validServerData.end() ) && ( nextPos != validServerData.end() ); ++pos, ++nextPos )
-    {
-        if ( !( *pos ).second->userDataEqual( *( ( *nextPos ).second ) ) )
-            return false;
-    }
-    return true;
+    return fUserDataEqual;
 }
 
 bool CMediaData::isMatch( const QString &name, int year ) const
@@ -691,34 +813,26 @@ bool CMediaData::isMissingProvider( EMissingProviderIDs missingIdsType ) const
 
     if ( ( missingIdsType & EMissingProviderIDs::eIMDBid ) != 0 )
     {
-        auto pos = fProviders.find( "Imdb" );
-        if ( pos == fProviders.end() )
-            return true;
-        return ( *pos ).second.isEmpty();
+        static const CSymbol sProvider( "Imdb" );
+        return !fProviders.has( sProvider );
     }
 
     if ( ( missingIdsType & EMissingProviderIDs::eTVRageid ) != 0 )
     {
-        auto pos = fProviders.find( "TvRage" );
-        if ( pos == fProviders.end() )
-            return true;
-        return ( *pos ).second.isEmpty();
+        static const CSymbol sProvider( "TvRage" );
+        return !fProviders.has( sProvider );
     }
 
     if ( ( missingIdsType & EMissingProviderIDs::eTMDBid ) != 0 )
     {
-        auto pos = fProviders.find( "Tmdb" );
-        if ( pos == fProviders.end() )
-            return true;
-        return ( *pos ).second.isEmpty();
+        static const CSymbol sProvider( "Tmdb" );
+        return !fProviders.has( sProvider );
     }
 
     if ( ( missingIdsType & EMissingProviderIDs::eTVDBid ) != 0 )
     {
-        auto pos = fProviders.find( "Tvdb" );
-        if ( pos == fProviders.end() )
-            return true;
-        return ( *pos ).second.isEmpty();
+        static const CSymbol sProvider( "Tvdb" );
+        return !fProviders.has( sProvider );
     }
     return false;
 }
@@ -23,6 +23,10 @@
 #ifndef __MEDIADATA_H
 #define __MEDIADATA_H
 
+#include "MediaServerData.h"
+#include "ProviderIDs.h"
+#include "Symbol.h"
+
 #include <QString>
 #include <QUrlQuery>
 #include <QDateTime>
@@ -32,6 +36,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <vector>
 class CServerInfo;
 class CMediaModel;
 class QJsonObject;
@@ -40,7 +45,6 @@ class CServerModel;
 class CSyncSystem;
 class QMenu;
 struct SMovieStub;
-struct SMediaServerData;
 
 enum class EMediaSyncStatus
 {
@@ -58,6 +62,15 @@ enum EMissingProviderIDs : uint8_t
     eTVRageid = 0x08
 };
 
+enum class EUserDataField : uint8_t
+{
+    ePlayed = 0x01,
+    eFavorite = 0x02,
+    eLastPlayed = 0x04,
+    ePlayCount = 0x08,
+    ePlaybackPosition = 0x10
+};
+
 class CMediaData
 {
 public:
@@ -76,39 +89,70 @@ public:
     QString name() const;
     QString originalTitle() const { return fOriginalTitle; }
     QString seriesName() const;
+    CSymbol seriesNameSymbol() const { return fSeriesName; }
     QString mediaType() const;
+    CSymbol mediaTypeSymbol() const { return fType; }
     bool beenLoaded( const QString &serverName ) const;
 
     void loadData( const QString &serverName, const QJsonObject &object );
-    void updateFromOther( const QString &otherServerName, std::shared_ptr< CMediaData > other );
+    void loadUserData( const QString &serverName, const QJsonObject &userDataObj );   // only the user data, the metadata is left as is
+    void clearUserData( const QString &serverName );
+    void hideFromUser( const QString &serverName );   // treated as not on the server until the user data is loaded again
+    void updateFromOther( const QString &otherServerName, const std::shared_ptr< CMediaData > &other );
+    void updateFromOther( int otherServerNum, const std::shared_ptr< CMediaData > &other );
 
     QUrlQuery getSearchForMediaQuery() const;
 
     QString getProviderID( const QString &provider );
-    std::map< QString, QString > getProviders( bool addKeyIfEmpty = false ) const;
+    QString getProviderID( const CSymbol &provider ) const;
+    std::map< QString, QString > getProviders( bool addKeyIfEmpty = false ) const;   // sorted by provider name
+    // func( const CSymbol &providerName, CProviderIDs::TValue value ), visits the packed ids without building strings
+    template< typename TFunc >
+    void forEachProviderKey( bool addKeyIfEmpty, TFunc func ) const
+    {
+        if ( addKeyIfEmpty && fProviders.empty() )
+            func( fType, CProviderIDs::encode( fName ) );
+        fProviders.forEach( func );
+    }
+    // func( const CSymbol &providerName, const QString &providerID )
+    template< typename TFunc >
+    void forEachProvider( bool addKeyIfEmpty, TFunc func ) const
+    {
+        forEachProviderKey( addKeyIfEmpty, [ &func ]( const CSymbol &providerName, CProviderIDs::TValue value ) { func( providerName, CProviderIDs::decode( value ) ); } );
+    }
     std::map< QString, QString > getExternalUrls() const { return fExternalUrls; }
 
     QString externalUrlsText() const;
 
     QString getMediaID( const QString &serverName ) const;
+    QString getMediaID( int serverNum ) const;
     void setMediaID( const QString &serverName, const QString &id );
 
-    void updateCanBeSynced();
+    // the per server data is indexed by the servers position in the server model,
+    // the server name versions look the position up and are kept for convenience
+    int serverNum( const QString &serverName ) const;
+    const SMediaServerData *serverData( int serverNum ) const;   // null when the media has no data for the server, or it is hidden from the current user
+    int newestServer() const;   // -1 when no server has valid data
 
     bool isValidForServer( const QString &serverName ) const;
+    bool isValidForServer( int serverNum ) const;
     bool isValidForAllServers() const;
     bool canBeSynced() const;
     bool validUserDataEqual() const;
     EMediaSyncStatus syncStatus() const;
+    bool userDataDiffers( EUserDataField field ) const;   // true when the valid servers do not agree on the field
 
     bool needsUpdating( const QString &serverName ) const;
+    bool needsUpdating( int serverNum ) const;
     template< class T >
     void needsUpdating( T ) const = delete;
 
     bool allPlayedEqual() const;
     bool isPlayed( const QString &serverName ) const;
+    bool isPlayed( int serverNum ) const;
 
     QString playbackPosition( const QString &serverName ) const;
+    QString playbackPosition( int serverNum ) const;
     uint64_t playbackPositionMSecs( const QString &serverName ) const;
     uint64_t playbackPositionTicks( const QString &serverName ) const;
     QTime playbackPositionTime( const QString &serverName ) const;
@@ -120,19 +164,23 @@ public:
 
     bool allFavoriteEqual() const;
     bool isFavorite( const QString &serverName ) const;
+    bool isFavorite( int serverNum ) const;
 
     QDateTime lastPlayed( const QString &serverName ) const;
+    QDateTime lastPlayed( int serverNum ) const;
     bool allLastPlayedEqual() const;
 
     uint64_t playCount( const QString &serverName ) const;
+    uint64_t playCount( int serverNum ) const;
     bool allPlayCountEqual() const;
 
     QDate premiereDate() const { return fPremiereDate; }
 
-    std::shared_ptr< SMediaServerData > userMediaData( const QString &serverName ) const;
-    std::shared_ptr< SMediaServerData > newestMediaData() const;
+    std::shared_ptr< SMediaServerData > userMediaData( const QString &serverName ) const;   // a copy, null when the media has no data for the server
+    std::shared_ptr< SMediaServerData > newestMediaData() const;   // a copy
 
     QIcon getDirectionIcon( const QString &serverName ) const;
+    QIcon getDirectionIcon( int serverNum ) const;
 
     enum class ESearchSite
     {
@@ -153,37 +201,28 @@ private:
     void computeName( const QJsonObject &media );
     void loadResolution( const QJsonArray &mediaSources );
 
-    template< typename T >
-    bool allEqual( std::function< T( std::shared_ptr< SMediaServerData > ) > func ) const
-    {
-        std::optional< T > prevValue;
-        for ( auto &&ii : fInfoForServer )
-        {
-            if ( !ii.second->isValid() )
-                continue;
-
-            if ( !prevValue.has_value() )
-                prevValue = func( ii.second );
-            else if ( prevValue.value() != func( ii.second ) )
-                return false;
-        }
-        return true;
-    }
+    SMediaServerData *mutableServerData( int serverNum );
+    // recomputes the cached sync state, must be called whenever the per server data changes
+    void updateSyncState();
     QString getProviderList() const;
 
-    QString fType;
+    CSymbol fType;
     QString fName;
     QString fOriginalTitle;
-    QString fSeriesName;   // only valid for EpisodeTypes
+    CSymbol fSeriesName;   // only valid for EpisodeTypes
     std::optional< int > fSeason;   // only valid for EpisodeTypes
     std::optional< int > fEpisode;   // only valid for EpisodeTypes
-    std::map< QString, QString > fProviders;
+    CProviderIDs fProviders;
     std::map< QString, QString > fExternalUrls;
     std::pair< int, int > fResolution{ 0, 0 };
     QDate fPremiereDate;
 
     bool fCanBeSynced{ false };
-    std::map< QString, std::shared_ptr< SMediaServerData > > fInfoForServer;
+    bool fUserDataEqual{ true };
+    uint8_t fUserDataDiffs{ 0 };   // EUserDataField bits that differ across the valid servers
+    int fNewestServer{ -1 };
+    std::shared_ptr< CServerModel > fServerModel;
+    std::vector< std::optional< SMediaServerData > > fInfoForServer;   // server position -> data, empty when the media is not on the server
 
     static std::function< QString( uint64_t ) > sMSecsToStringFunc;
 };
@@ -0,0 +1,93 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "MediaID.h"
+#include "SABUtils/HashUtils.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    struct SInternedIDs
+    {
+        std::mutex fMutex;
+        std::vector< QString > fIDs;
+        std::unordered_map< QString, uint64_t > fPositions;
+    };
+
+    SInternedIDs &internedIDs()
+    {
+        static SInternedIDs sInternedIDs;
+        return sInternedIDs;
+    }
+
+    // only ids that print back the same way are stored as numbers, so "007" stays a string
+    bool isCanonicalNumber( const QString &mediaID )
+    {
+        if ( mediaID.isEmpty() || ( mediaID.length() > 18 ) )
+            return false;
+        if ( ( mediaID.length() > 1 ) && ( mediaID[ 0 ] == '0' ) )
+            return false;
+        for ( auto &&ii : mediaID )
+        {
+            if ( ( ii < '0' ) || ( ii > '9' ) )
+                return false;
+        }
+        return true;
+    }
+}
+
+CMediaID::CMediaID( const QString &mediaID )
+{
+    if ( mediaID.isEmpty() )
+        return;
+
+    if ( isCanonicalNumber( mediaID ) )
+    {
+        fValue = mediaID.toULongLong();
+        return;
+    }
+
+    auto &&interned = internedIDs();
+    std::lock_guard< std::mutex > lock( interned.fMutex );
+    auto pos = interned.fPositions.find( mediaID );
+    if ( pos == interned.fPositions.end() )
+    {
+        pos = interned.fPositions.insert( std::make_pair( mediaID, static_cast< uint64_t >( interned.fIDs.size() ) ) ).first;
+        interned.fIDs.push_back( mediaID );
+    }
+    fValue = sInternedBit | ( *pos ).second;
+}
+
+QString CMediaID::toString() const
+{
+    if ( !isValid() )
+        return {};
+    if ( isNumeric() )
+        return QString::number( fValue );
+
+    auto &&interned = internedIDs();
+    std::lock_guard< std::mutex > lock( interned.fMutex );
+    return interned.fIDs[ fValue & ~sInternedBit ];
+}
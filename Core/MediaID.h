@@ -0,0 +1,54 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __MEDIAID_H
+#define __MEDIAID_H
+
+#include <QString>
+
+#include <cstdint>
+
+// A server's id for a media item.  Emby ids are decimal strings, so they are kept as the number
+// itself, any other id is interned once and kept as its position in the intern table
+class CMediaID
+{
+public:
+    CMediaID() = default;
+    explicit CMediaID( const QString &mediaID );
+
+    bool isValid() const { return fValue != sInvalid; }
+    bool isNumeric() const { return isValid() && ( ( fValue & sInternedBit ) == 0 ); }
+    uint64_t value() const { return fValue; }
+
+    QString toString() const;
+
+    bool operator==( const CMediaID &rhs ) const { return fValue == rhs.fValue; }
+    bool operator!=( const CMediaID &rhs ) const { return fValue != rhs.fValue; }
+
+private:
+    static constexpr uint64_t sInternedBit = 1ULL << 63;
+    static constexpr uint64_t sInvalid = ~0ULL;
+
+    uint64_t fValue{ sInvalid };
+};
+
+#endif
@@ -0,0 +1,137 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "MediaIndex.h"
+#include "MediaData.h"
+
+std::shared_ptr< CMediaData > CMediaIndex::find( int serverNum, const CMediaID &mediaID ) const
+{
+    if ( fEntries.empty() )
+        return {};
+
+    auto &&entry = fEntries[ findSlot( serverNum, mediaID ) ];
+    if ( entry.fServerNum == -1 )
+        return {};
+    return entry.fMediaData;
+}
+
+void CMediaIndex::insert( int serverNum, const CMediaID &mediaID, const std::shared_ptr< CMediaData > &mediaData )
+{
+    if ( serverNum < 0 )
+        return;
+
+    if ( !fEntries.empty() )
+    {
+        auto &&entry = fEntries[ findSlot( serverNum, mediaID ) ];
+        if ( entry.fServerNum != -1 )
+        {
+            entry.fMediaData = mediaData;
+            return;
+        }
+    }
+
+    // keep the load at or below 1/2 so the probes stay short
+    if ( ( fSize + 1 ) * 2 > fEntries.size() )
+        grow();
+
+    auto &&entry = fEntries[ findSlot( serverNum, mediaID ) ];
+    entry.fServerNum = serverNum;
+    entry.fMediaID = mediaID;
+    entry.fMediaData = mediaData;
+    fSize++;
+}
+
+bool CMediaIndex::erase( int serverNum, const CMediaID &mediaID )
+{
+    if ( fEntries.empty() )
+        return false;
+
+    auto slot = findSlot( serverNum, mediaID );
+    if ( fEntries[ slot ].fServerNum == -1 )
+        return false;
+
+    fEntries[ slot ] = SEntry();
+    fSize--;
+
+    // shift the following entries of the probe back, so no tombstones are needed
+    auto mask = fEntries.size() - 1;
+    auto next = ( slot + 1 ) & mask;
+    while ( fEntries[ next ].fServerNum != -1 )
+    {
+        auto home = homeSlot( fEntries[ next ].fServerNum, fEntries[ next ].fMediaID );
+        auto distNext = ( next - home ) & mask;
+        auto distSlot = ( slot - home ) & mask;
+        if ( distSlot < distNext )
+        {
+            fEntries[ slot ] = std::move( fEntries[ next ] );
+            fEntries[ next ] = SEntry();
+            slot = next;
+        }
+        next = ( next + 1 ) & mask;
+    }
+    return true;
+}
+
+void CMediaIndex::clear()
+{
+    fEntries.clear();
+    fSize = 0;
+}
+
+size_t CMediaIndex::homeSlot( int serverNum, const CMediaID &mediaID ) const
+{
+    // splitmix64 finalizer over the id mixed with the server position
+    auto hash = mediaID.value() ^ ( static_cast< uint64_t >( serverNum ) * 0x9E3779B97F4A7C15ULL );
+    hash = ( hash ^ ( hash >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+    hash = ( hash ^ ( hash >> 27 ) ) * 0x94D049BB133111EBULL;
+    hash = hash ^ ( hash >> 31 );
+    return static_cast< size_t >( hash ) & ( fEntries.size() - 1 );
+}
+
+size_t CMediaIndex::findSlot( int serverNum, const CMediaID &mediaID ) const
+{
+    auto mask = fEntries.size() - 1;
+    auto slot = homeSlot( serverNum, mediaID );
+    while ( fEntries[ slot ].fServerNum != -1 )
+    {
+        if ( ( fEntries[ slot ].fServerNum == serverNum ) && ( fEntries[ slot ].fMediaID == mediaID ) )
+            break;
+        slot = ( slot + 1 ) & mask;
+    }
+    return slot;
+}
+
+void CMediaIndex::grow()
+{
+    auto oldEntries = std::move( fEntries );
+    fEntries = std::vector< SEntry >( oldEntries.empty() ? 64 : oldEntries.size() * 2 );
+    fSize = 0;
+    for ( auto &&ii : oldEntries )
+    {
+        if ( ii.fServerNum == -1 )
+            continue;
+
+        auto &&entry = fEntries[ findSlot( ii.fServerNum, ii.fMediaID ) ];
+        entry = std::move( ii );
+        fSize++;
+    }
+}
@@ -0,0 +1,73 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __MEDIAINDEX_H
+#define __MEDIAINDEX_H
+
+#include "MediaID.h"
+
+#include <memory>
+#include <vector>
+
+class CMediaData;
+
+// (server position, media id) -> media
+// open addressing with linear probing, so a lookup is normally a single probe into one flat array
+class CMediaIndex
+{
+public:
+    std::shared_ptr< CMediaData > find( int serverNum, const CMediaID &mediaID ) const;
+    void insert( int serverNum, const CMediaID &mediaID, const std::shared_ptr< CMediaData > &mediaData );   // replaces any existing entry
+    bool erase( int serverNum, const CMediaID &mediaID );
+
+    size_t size() const { return fSize; }
+    bool empty() const { return fSize == 0; }
+    void clear();
+
+    // func( int serverNum, const CMediaID &mediaID, const std::shared_ptr< CMediaData > &mediaData )
+    template< typename TFunc >
+    void forEach( TFunc func ) const
+    {
+        for ( auto &&ii : fEntries )
+        {
+            if ( ii.fServerNum != -1 )
+                func( ii.fServerNum, ii.fMediaID, ii.fMediaData );
+        }
+    }
+
+private:
+    struct SEntry
+    {
+        int fServerNum{ -1 };   // -1 when the slot is empty
+        CMediaID fMediaID;
+        std::shared_ptr< CMediaData > fMediaData;
+    };
+
+    size_t homeSlot( int serverNum, const CMediaID &mediaID ) const;
+    size_t findSlot( int serverNum, const CMediaID &mediaID ) const;   // the matching slot or the empty slot that ends the probe
+    void grow();
+
+    std::vector< SEntry > fEntries;   // the size is always 0 or a power of 2
+    size_t fSize{ 0 };
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "MediaModel.h"
+#include "MediaCatalog.h"
 #include "MediaData.h"
 #include "MergeMedia.h"
 #include "MovieStub.h"
@@ -16,6 +17,8 @@
 #include <QInputDialog>
 #include <QTimer>
 
+#include <algorithm>
+#include <functional>
 #include <optional>
 #include <vector>
 #include <unordered_map>
@@ -24,7 +27,8 @@ CMediaModel::CMediaModel( std::shared_ptr< CSettings > settings, std::shared_ptr
     QAbstractTableModel( parent ),
     fSettings( settings ),
     fServerModel( serverModel ),
-    fMergeSystem( new CMergeMedia )
+    fMergeSystem( new CMergeMedia( serverModel ) ),
+    fCatalog( new CMediaCatalog )
 {
     connect( this, &CMediaModel::dataChanged, this, &CMediaModel::sigMediaChanged );
     connect( this, &CMediaModel::modelReset, this, &CMediaModel::sigMediaChanged );
@@ -81,6 +85,15 @@ QString CMediaModel::serverForColumn( int column ) const
     return fServerModel->getServerInfo( serverNum )->keyName();
 }
 
+int CMediaModel::serverNumForColumn( int column ) const
+{
+    auto providerInfo = getProviderInfoForColumn( column );
+    if ( providerInfo )
+        return fServerModel->getServerPos( providerInfo.value().first );
+
+    return column / columnsPerServer( false );
+}
+
 std::list< int > CMediaModel::providerColumns() const
 {
     std::list< int > retVal;
@@ -89,7 +102,7 @@ std::list< int > CMediaModel::providerColumns() const
     return retVal;
 }
 
-std::optional< std::pair< QString, QString > > CMediaModel::getProviderInfoForColumn( int column ) const
+std::optional< std::pair< QString, CSymbol > > CMediaModel::getProviderInfoForColumn( int column ) const
 {
     auto pos = fProviderColumnsByColumn.find( column );
     if ( pos != fProviderColumnsByColumn.end() )
@@ -172,12 +185,12 @@ QVariant CMediaModel::data( const QModelIndex &index, int role /*= Qt::DisplayRo
     }
 
     int column = index.column();
-    auto serverName = this->serverForColumn( column );
+    auto serverNum = this->serverNumForColumn( column );
 
     // reverse for black background
     if ( role == Qt::ForegroundRole )
     {
-        auto color = getColor( index, serverName, false );
+        auto color = getColor( index, serverNum, false );
         if ( !color.isValid() )
             return {};
         return color;
@@ -185,7 +198,7 @@ QVariant CMediaModel::data( const QModelIndex &index, int role /*= Qt::DisplayRo
 
     if ( role == Qt::BackgroundRole )
     {
-        auto color = getColor( index, serverName, true );
+        auto color = getColor( index, serverNum, true );
         if ( !color.isValid() )
             return {};
         return color;
@@ -193,7 +206,7 @@ QVariant CMediaModel::data( const QModelIndex &index, int role /*= Qt::DisplayRo
 
     if ( ( role == Qt::DecorationRole ) && ( perServerColumn( column ) == eName ) )
     {
-        return mediaData->getDirectionIcon( serverName );
+        return mediaData->getDirectionIcon( serverNum );
     }
 
     if ( role != Qt::DisplayRole )
@@ -205,7 +218,7 @@ QVariant CMediaModel::data( const QModelIndex &index, int role /*= Qt::DisplayRo
         return mediaData->getProviderID( providerInfo.value().second );
     }
 
-    bool isValid = mediaData->isValidForServer( serverName );
+    bool isValid = mediaData->isValidForServer( serverNum );
 
     switch ( perServerColumn( column ) )
     {
@@ -221,17 +234,17 @@ QVariant CMediaModel::data( const QModelIndex &index, int role /*= Qt::DisplayRo
                     return mediaData->premiereDate();
             }
         case eMediaID:
-            return isValid ? mediaData->getMediaID( serverName ) : QString();
+            return isValid ? mediaData->getMediaID( serverNum ) : QString();
         case eFavorite:
-            return isValid ? ( mediaData->isFavorite( serverName ) ? "Yes" : "No" ) : QString();
+            return isValid ? ( mediaData->isFavorite( serverNum ) ? "Yes" : "No" ) : QString();
         case ePlayed:
-            return isValid ? ( mediaData->isPlayed( serverName ) ? "Yes" : "No" ) : QString();
+            return isValid ? ( mediaData->isPlayed( serverNum ) ? "Yes" : "No" ) : QString();
         case eLastPlayed:
-            return isValid ? ( mediaData->lastPlayed( serverName ).toString() ) : QString();
+            return isValid ? ( mediaData->lastPlayed( serverNum ).toString() ) : QString();
         case ePlayCount:
-            return isValid ? QString::number( mediaData->playCount( serverName ) ) : QString();
+            return isValid ? QString::number( mediaData->playCount( serverNum ) ) : QString();
         case ePlaybackPosition:
-            return isValid ? mediaData->playbackPosition( serverName ) : QString();
+            return isValid ? mediaData->playbackPosition( serverNum ) : QString();
         case eResolution:
             return mediaData->resolution();
         default:
@@ -249,17 +262,15 @@ int CMediaModel::perServerColumn( int column ) const
     return column % columnsPerServer( false );
 }
 
-void CMediaModel::addMediaInfo( const QString &serverName, std::shared_ptr< CMediaData > mediaData, const QJsonObject &mediaInfo )
+void CMediaModel::addMediaInfo( const QString &serverName, const std::shared_ptr< CMediaData > &mediaData, const QJsonObject &mediaInfo )
 {
     mediaData->loadData( serverName, mediaInfo );
 
-    fMediaMap[ serverName ][ mediaData->getMediaID( serverName ) ] = mediaData;
-
     fMergeSystem->addMediaInfo( serverName, mediaData );
     updateMediaData( mediaData );
 }
 
-void CMediaModel::updateMediaData( std::shared_ptr< CMediaData > mediaData )
+void CMediaModel::updateMediaData( const std::shared_ptr< CMediaData > &mediaData )
 {
     auto pos = fMediaToPos.find( mediaData );
     if ( pos == fMediaToPos.end() )
@@ -293,7 +304,7 @@ QVariant CMediaModel::headerData( int section, Qt::Orientation orientation, int
     int columnNum = -1;
     auto providerInfo = getProviderInfoForColumn( section );
     if ( providerInfo )
-        retVal = providerInfo.value().second;
+        retVal = providerInfo.value().second.toString();
     else
     {
         columnNum = perServerColumn( section );
@@ -341,12 +352,13 @@ void CMediaModel::clear()
     beginResetModel();
 
     fMergeSystem->clear();
-    fAllMedia.clear();
-    fMediaMap.clear();
+    fCatalog->clear();
     // fCollections.clear();
     fData.clear();
     fDataMap.clear();
     fMediaToPos.clear();
+    fUserDataSeen.clear();
+    fUserDataGaps.clear();
     fProviderNames.clear();
     fProviderColumnsByColumn.clear();
     fDirSort = eNoSort;
@@ -354,24 +366,26 @@ void CMediaModel::clear()
     endResetModel();
 }
 
-void CMediaModel::updateProviderColumns( std::shared_ptr< CMediaData > mediaData )
+void CMediaModel::updateProviderColumns( const std::shared_ptr< CMediaData > &mediaData )
 {
-    for ( auto &&ii : mediaData->getProviders() )
-    {
-        int colCount = this->columnCount();
-        auto pos = fProviderNames.find( ii.first );
-        if ( pos == fProviderNames.end() )
+    mediaData->forEachProviderKey(
+        false,
+        [ this ]( const CSymbol &providerName, CProviderIDs::TValue /*providerID*/ )
         {
-            auto serverModel = fServerModel;
-            beginInsertColumns( QModelIndex(), colCount, colCount + serverModel->serverCnt() - 1 );
-            fProviderNames.insert( ii.first );
-            for ( int jj = 0; jj < serverModel->serverCnt(); ++jj )
+            int colCount = this->columnCount();
+            auto pos = fProviderNames.find( providerName );
+            if ( pos == fProviderNames.end() )
             {
-                fProviderColumnsByColumn[ colCount + jj ] = { serverModel->getServerInfo( jj )->keyName(), ii.first };   // gets duplicated lhs vs rhs
+                auto serverModel = fServerModel;
+                beginInsertColumns( QModelIndex(), colCount, colCount + serverModel->serverCnt() - 1 );
+                fProviderNames.insert( providerName );
+                for ( int jj = 0; jj < serverModel->serverCnt(); ++jj )
+                {
+                    fProviderColumnsByColumn[ colCount + jj ] = { serverModel->getServerInfo( jj )->keyName(), providerName };   // gets duplicated lhs vs rhs
+                }
+                endInsertColumns();
             }
-            endInsertColumns();
-        }
-    }
+        } );
 }
 
 void CMediaModel::settingsChanged()
@@ -393,30 +407,35 @@ std::shared_ptr< CMediaData > CMediaModel::getMediaData( const QModelIndex &idx
 
 std::shared_ptr< CMediaData > CMediaModel::getMediaDataForID( const QString &serverName, const QString &mediaID ) const
 {
-    auto pos = fMediaMap.find( serverName );
-    if ( pos == fMediaMap.end() )
-        return {};
+    return fMergeSystem->findMedia( serverName, mediaID );
+}
 
-    auto pos2 = ( *pos ).second.find( mediaID );
-    if ( pos2 != ( *pos ).second.end() )
-        return ( *pos2 ).second;
-    return {};
+void CMediaModel::forEachMediaOnServer( const QString &serverName, std::function< void( const std::shared_ptr< CMediaData > &mediaData ) > func ) const
+{
+    fMergeSystem->forEachMediaOnServer( serverName, func );
 }
 
-std::shared_ptr< CMediaData > CMediaModel::loadMedia( const QString &serverName, const QJsonObject &media )
+const CMediaModel::TMediaSet &CMediaModel::getAllMedia() const
 {
-    auto id = media[ "Id" ].toString();
-    std::shared_ptr< CMediaData > mediaData;
+    return fMergeSystem->mergedMedia();
+}
 
-    auto pos = fMediaMap.find( serverName );
-    if ( pos == fMediaMap.end() )
-        pos = fMediaMap.insert( std::make_pair( serverName, TMediaIDToMediaData() ) ).first;
+CMediaModel::const_iterator CMediaModel::begin() const
+{
+    return getAllMedia().cbegin();
+}
 
-    auto pos2 = ( *pos ).second.find( id );
-    if ( pos2 == ( *pos ).second.end() )
-        mediaData = std::make_shared< CMediaData >( media, fServerModel );
-    else
-        mediaData = ( *pos2 ).second;
+CMediaModel::const_iterator CMediaModel::end() const
+{
+    return getAllMedia().cend();
+}
+
+std::shared_ptr< CMediaData > CMediaModel::loadMedia( const QString &serverName, const QJsonObject &media )
+{
+    auto id = media[ "Id" ].toString();
+    auto mediaData = fMergeSystem->findMedia( serverName, id );
+    if ( !mediaData )
+        mediaData = fCatalog->shared( fCatalog->create( media, fServerModel ) );
     // qDebug() << isLHSServer << mediaData->name();
 
     mediaData->setMediaID( serverName, id );
@@ -437,18 +456,7 @@ std::shared_ptr< CMediaData > CMediaModel::loadMedia( const QString &serverName,
 
 void CMediaModel::removeMedia( const QString &serverName, const std::shared_ptr< CMediaData > &mediaData )
 {
-    auto pos = fMediaMap.find( serverName );
-    if ( pos != fMediaMap.end() )
-    {
-        auto mediaID = mediaData->getMediaID( serverName );
-        auto pos2 = ( *pos ).second.find( mediaID );
-        if ( pos2 != ( *pos ).second.end() )
-            ( *pos ).second.erase( pos2 );
-
-        auto pos3 = fMediaToPos.find( mediaData );
-        if ( pos3 != fMediaToPos.end() )
-            fMediaToPos.erase( pos3 );
-    }
+    // the row is removed by the next merge, once it is known the media is not on any other server
     fMergeSystem->removeMedia( serverName, mediaData );
 }
 
@@ -466,13 +474,103 @@ std::shared_ptr< CMediaData > CMediaModel::reloadMedia( const QString &serverNam
     return mediaData;
 }
 
+void CMediaModel::beginUserDataLoad( const QString &serverName )
+{
+    fUserDataSeen[ serverName ].clear();
+    fUserDataGaps.erase( serverName );
+}
+
+bool CMediaModel::loadUserData( const QString &serverName, const QJsonObject &media )
+{
+    auto mediaData = getMediaDataForID( serverName, media[ "Id" ].toString() );
+    if ( !mediaData )
+        return false;
+
+    mediaData->loadUserData( serverName, media[ "UserData" ].toObject() );
+    fUserDataSeen[ serverName ].insert( mediaData.get() );
+    updateMediaData( mediaData );
+    return true;
+}
+
+int CMediaModel::endUserDataLoad( const QString &serverName, bool unseenHidden )
+{
+    auto pos = fUserDataSeen.find( serverName );
+    if ( pos == fUserDataSeen.end() )
+        return 0;
+
+    auto seen = std::move( ( *pos ).second );
+    fUserDataSeen.erase( pos );
+
+    std::unordered_set< const CMediaData * > gaps;
+    auto gapsPos = fUserDataGaps.find( serverName );
+    if ( gapsPos != fUserDataGaps.end() )
+    {
+        gaps = std::move( ( *gapsPos ).second );
+        fUserDataGaps.erase( gapsPos );
+    }
+
+    // their play state is from the previous user, the user can not see them or they have the default play state
+    int numUnseen = 0;
+    forEachMediaOnServer(
+        serverName,
+        [ this, &seen, &gaps, &serverName, &numUnseen, unseenHidden ]( const std::shared_ptr< CMediaData > &mediaData )
+        {
+            if ( seen.find( mediaData.get() ) != seen.end() )
+                return;
+            if ( unseenHidden || ( gaps.find( mediaData.get() ) != gaps.end() ) )
+                mediaData->hideFromUser( serverName );
+            else
+                mediaData->clearUserData( serverName );
+            updateMediaData( mediaData );
+            numUnseen++;
+        } );
+    return numUnseen;
+}
+
+void CMediaModel::cancelUserDataLoad( const QString &serverName )
+{
+    fUserDataSeen.erase( serverName );
+    fUserDataGaps.erase( serverName );
+}
+
+std::map< QString, QStringList > CMediaModel::sparseUserDataGaps()
+{
+    std::map< QString, QStringList > retVal;
+    for ( auto &&ii : fUserDataSeen )
+    {
+        auto &&serverName = ii.first;
+        auto &&gaps = fUserDataGaps[ serverName ];
+        for ( auto &&jj : fUserDataSeen )
+        {
+            if ( jj.first == serverName )
+                continue;
+
+            for ( auto &&mediaData : jj.second )
+            {
+                if ( ( ii.second.find( mediaData ) != ii.second.end() ) || ( gaps.find( mediaData ) != gaps.end() ) )
+                    continue;
+
+                auto mediaID = mediaData->getMediaID( serverName );
+                if ( mediaID.isEmpty() )
+                    continue;
+
+                gaps.insert( mediaData );
+                retVal[ serverName ] << mediaID;
+            }
+        }
+    }
+    return retVal;
+}
+
 bool CMediaModel::mergeMedia( std::shared_ptr< CProgressSystem > progressSystem )
 {
+    auto incremental = fMergeSystem->isMerged();
     if ( fMergeSystem->merge( progressSystem ) )
     {
-        std::tie( fAllMedia, fMediaMap ) = fMergeSystem->getMergedData( progressSystem );
-
-        loadMergedMedia( progressSystem );
+        if ( incremental )
+            loadMergeChanges( fMergeSystem->lastChanges() );
+        else
+            loadMergedMedia( progressSystem );
     }
     else
     {
@@ -485,11 +583,12 @@ void CMediaModel::loadMergedMedia( std::shared_ptr< CProgressSystem > progressSy
 {
     progressSystem->pushState();
     progressSystem->setTitle( tr( "Loading merged media data" ) );
-    progressSystem->setMaximum( static_cast< int >( fAllMedia.size() ) );
+    auto &&allMedia = getAllMedia();
+    progressSystem->setMaximum( static_cast< int >( allMedia.size() ) );
     progressSystem->setValue( 0 );
     beginResetModel();
-    fData.reserve( fAllMedia.size() );
-    for ( auto &&ii : fAllMedia )
+    fData.reserve( allMedia.size() );
+    for ( auto &&ii : allMedia )
     {
         addMedia( ii, false );
     }
@@ -497,6 +596,55 @@ void CMediaModel::loadMergedMedia( std::shared_ptr< CProgressSystem > progressSy
     progressSystem->popState();
 }
 
+void CMediaModel::loadMergeChanges( const SMergeChanges &changes )
+{
+    std::vector< int > removedRows;
+    for ( auto &&ii : changes.fRemoved )
+    {
+        for ( auto &&key : { SMovieStub::nameKey( ii->name() ), SMovieStub::nameKey( ii->originalTitle() ) } )
+        {
+            auto pos = fDataMap.find( key );
+            if ( ( pos != fDataMap.end() ) && ( ( *pos ).second == ii ) )
+                fDataMap.erase( pos );
+        }
+
+        auto pos = fMediaToPos.find( ii );
+        if ( pos == fMediaToPos.end() )
+            continue;
+        removedRows.push_back( static_cast< int >( ( *pos ).second ) );
+        fMediaToPos.erase( pos );
+    }
+
+    std::sort( removedRows.begin(), removedRows.end(), std::greater< int >() );
+    for ( auto &&row : removedRows )
+    {
+        beginRemoveRows( QModelIndex(), row, row );
+        fData.erase( fData.begin() + row );
+        endRemoveRows();
+    }
+    if ( !removedRows.empty() )
+    {
+        for ( size_t ii = removedRows.back(); ii < fData.size(); ++ii )
+            fMediaToPos[ fData[ ii ] ] = ii;
+    }
+
+    if ( !changes.fAdded.empty() )
+    {
+        // provider columns can not be inserted while the rows are being inserted
+        for ( auto &&ii : changes.fAdded )
+            updateProviderColumns( ii );
+
+        auto firstRow = static_cast< int >( fData.size() );
+        beginInsertRows( QModelIndex(), firstRow, firstRow + static_cast< int >( changes.fAdded.size() ) - 1 );
+        for ( auto &&ii : changes.fAdded )
+            addMedia( ii, false );
+        endInsertRows();
+    }
+
+    for ( auto &&ii : changes.fChanged )
+        updateMediaData( ii );
+}
+
 void CMediaModel::addMedia( const std::shared_ptr< CMediaData > &media, bool emitUpdate )
 {
     if ( emitUpdate )
@@ -581,26 +729,33 @@ void CMediaModel::addMovieStub( const SMovieStub &movieStub, std::function< bool
             return;
     }
 
-    auto mediaData = std::make_shared< CMediaData >( movieStub, "Movie" );
+    auto mediaData = fCatalog->shared( fCatalog->create( movieStub, "Movie" ) );
     addMedia( mediaData, true );
 }
 
 std::unordered_set< QString > CMediaModel::getKnownShows() const
 {
-    std::unordered_set< QString > knownShows;
-    for ( auto &&ii : fAllMedia )
+    static const CSymbol sEpisode( "Episode" );
+
+    // every episode of a show shares its series name symbol, only one string per show is made
+    std::unordered_set< CSymbol > showSymbols;
+    for ( auto &&ii : getAllMedia() )
     {
-        if ( ii->mediaType() != "Episode" )
+        if ( ii->mediaTypeSymbol() != sEpisode )
             continue;
-        ;
-        knownShows.insert( ii->seriesName() );
+        showSymbols.insert( ii->seriesNameSymbol() );
     }
+
+    std::unordered_set< QString > knownShows;
+    knownShows.reserve( showSymbols.size() );
+    for ( auto &&ii : showSymbols )
+        knownShows.insert( ii.toString() );
     return knownShows;
 }
 
 std::shared_ptr< CMediaData > CMediaModel::findMedia( const QString &name, int year ) const
 {
-    for ( auto &&ii : fAllMedia )
+    for ( auto &&ii : getAllMedia() )
     {
         if ( ii->isMatch( name, year ) )
             return ii;
@@ -608,7 +763,7 @@ std::shared_ptr< CMediaData > CMediaModel::findMedia( const QString &name, int y
     return {};
 }
 
-QVariant CMediaModel::getColor( const QModelIndex &index, const QString &serverName, bool background ) const
+QVariant CMediaModel::getColor( const QModelIndex &index, int serverNum, bool background ) const
 {
     if ( !index.isValid() )
         return {};
@@ -617,7 +772,7 @@ QVariant CMediaModel::getColor( const QModelIndex &index, const QString &serverN
         return {};
     auto mediaData = fData[ index.row() ];
 
-    if ( !mediaData->isValidForServer( serverName ) )
+    if ( !mediaData->isValidForServer( serverNum ) )
     {
         switch ( perServerColumn( index.column() ) )
         {
@@ -672,9 +827,7 @@ QVariant CMediaModel::getColor( const QModelIndex &index, const QString &serverN
 
         auto older = fSettings->mediaDestColor( background );
         auto newer = fSettings->mediaSourceColor( background );
-        auto serverName = this->serverForColumn( index.column() );
-
-        auto isOlder = mediaData->needsUpdating( serverName );
+        auto isOlder = mediaData->needsUpdating( serverNum );
 
         return isOlder ? older : newer;
     }
@@ -687,18 +840,19 @@ SMediaSummary::SMediaSummary( std::shared_ptr< CMediaModel > model )
     for ( auto &&ii : model->fData )
     {
         fTotalMedia++;
-        for ( auto &&serverInfo : *serverModel )
+        for ( int serverNum = 0; serverNum < serverModel->serverCnt(); ++serverNum )
         {
+            auto serverInfo = serverModel->getServerInfo( serverNum );
             if ( !serverInfo->isEnabled() )
                 continue;
 
-            if ( !ii->isValidForServer( serverInfo->keyName() ) )
+            if ( !ii->isValidForServer( serverNum ) )
             {
                 fMissingData[ serverInfo->displayName() ]++;
                 continue;
             }
 
-            if ( ii->needsUpdating( serverInfo->keyName() ) )
+            if ( ii->needsUpdating( serverNum ) )
             {
                 fNeedsUpdating[ serverInfo->displayName() ]++;
             }
@@ -2,10 +2,12 @@
 #define __MEDIAMODEL_H
 
 #include "IServerForColumn.h"
+#include "Symbol.h"
 
 #include <QAbstractTableModel>
 #include <QSortFilterProxyModel>
 
+#include <functional>
 #include <vector>
 #include <unordered_set>
 #include <unordered_map>
@@ -18,14 +20,14 @@ class CMediaCollection;
 struct SMediaCollectionData;
 class CProgressSystem;
 class CMergeMedia;
+class CMediaCatalog;
+struct SMergeChanges;
 class CServerModel;
 class CSyncSystem;
 class CServerInfo;
 class QJsonObject;
 struct SMovieStub;
 
-using TMediaIDToMediaData = std::map< QString, std::shared_ptr< CMediaData > >;
-
 class CMediaModel : public QAbstractTableModel, public IServerForColumn
 {
     friend struct SMediaSummary;
@@ -78,6 +80,7 @@ public:
     virtual QVariant headerData( int section, Qt::Orientation orientation, int role = Qt::DisplayRole ) const override;
 
     virtual QString serverForColumn( int column ) const override;
+    int serverNumForColumn( int column ) const;
     virtual std::list< int > columnsForBaseColumn( int baseColumn ) const override;
     virtual std::list< int > providerColumns() const;
 
@@ -89,9 +92,25 @@ public:
 
     std::shared_ptr< CMediaData > getMediaData( const QModelIndex &idx ) const;
     std::shared_ptr< CMediaData > getMediaDataForID( const QString &serverName, const QString &mediaID ) const;
+    void forEachMediaOnServer( const QString &serverName, std::function< void( const std::shared_ptr< CMediaData > &mediaData ) > func ) const;
     std::shared_ptr< CMediaData > loadMedia( const QString &serverName, const QJsonObject &media );
     std::shared_ptr< CMediaData > reloadMedia( const QString &serverName, const QJsonObject &media, const QString &mediaID );
 
+    // applies a user's play state onto media that is already loaded, so one catalog can be shared by every user.
+    // loadUserData returns false when the item is not loaded.  endUserDataLoad hides the media the user did not
+    // get back, it is not on the server for them, and returns how many were hidden.  When unseenHidden is false
+    // (a sparse load) the media is kept with the default play state instead, except for the gaps that were
+    // asked for by ID and still did not come back
+    void beginUserDataLoad( const QString &serverName );
+    bool loadUserData( const QString &serverName, const QJsonObject &media );
+    int endUserDataLoad( const QString &serverName, bool unseenHidden );
+    void cancelUserDataLoad( const QString &serverName );   // the media that was not returned keeps its play state
+
+    // serverName -> IDs of the media another server returned a play state for, but this one did not.  A sparse
+    // load can not tell whether they are default on the server, possibly changed more recently than the other
+    // server, or not visible.  They are remembered as asked for
+    std::map< QString, QStringList > sparseUserDataGaps();
+
     void removeMedia( const QString &serverName, const std::shared_ptr< CMediaData > &media );
 
     void beginBatchLoad();
@@ -100,23 +119,21 @@ public:
     bool mergeMedia( std::shared_ptr< CProgressSystem > progressSystem );
 
     void loadMergedMedia( std::shared_ptr< CProgressSystem > progressSystem );
+    void loadMergeChanges( const SMergeChanges &changes );
 
     void addMedia( const std::shared_ptr< CMediaData > &media, bool emitUpdate );
 
     using TMediaSet = std::unordered_set< std::shared_ptr< CMediaData > >;
 
-    TMediaSet getAllMedia() const { return fAllMedia; }
+    const TMediaSet &getAllMedia() const;   // owned by the merge system
     std::unordered_set< QString > getKnownShows() const;
 
     std::shared_ptr< CMediaData > findMedia( const QString &name, int year ) const;
 
-    using iterator = typename TMediaSet::iterator;
     using const_iterator = typename TMediaSet::const_iterator;
 
-    iterator begin() { return fAllMedia.begin(); }
-    iterator end() { return fAllMedia.end(); }
-    const_iterator begin() const { return fAllMedia.cbegin(); }
-    const_iterator end() const { return fAllMedia.cend(); }
+    const_iterator begin() const;
+    const_iterator end() const;
 
     void addMovieStub( const SMovieStub &movieStub, std::function< bool( std::shared_ptr< CMediaData > mediaData ) > equal );
     void removeMovieStub( const SMovieStub &movieStub );
@@ -134,24 +151,24 @@ private:
     int perServerColumn( int column ) const;
     int columnsPerServer( bool includeProviders = true ) const;
 
-    std::optional< std::pair< QString, QString > > getProviderInfoForColumn( int column ) const;
+    std::optional< std::pair< QString, CSymbol > > getProviderInfoForColumn( int column ) const;
 
-    void addMediaInfo( const QString &serverName, std::shared_ptr< CMediaData > mediaData, const QJsonObject &mediaInfo );
-    void updateMediaData( std::shared_ptr< CMediaData > mediaData );
+    void addMediaInfo( const QString &serverName, const std::shared_ptr< CMediaData > &mediaData, const QJsonObject &mediaInfo );
+    void updateMediaData( const std::shared_ptr< CMediaData > &mediaData );
 
-    QVariant getColor( const QModelIndex &index, const QString &serverName, bool background ) const;
-    void updateProviderColumns( std::shared_ptr< CMediaData > ii );
+    QVariant getColor( const QModelIndex &index, int serverNum, bool background ) const;
+    void updateProviderColumns( const std::shared_ptr< CMediaData > &ii );
 
     std::unique_ptr< CMergeMedia > fMergeSystem;
-
-    TMediaSet fAllMedia;
-    std::map< QString, TMediaIDToMediaData > fMediaMap;   // serverName -> mediaID -> mediaData
+    std::unique_ptr< CMediaCatalog > fCatalog;   // owns the media, freed in one shot by clear
 
     std::vector< std::shared_ptr< CMediaData > > fData;
     std::unordered_map< QString, std::shared_ptr< CMediaData > > fDataMap;
     std::unordered_map< std::shared_ptr< CMediaData >, size_t > fMediaToPos;
-    std::unordered_set< QString > fProviderNames;
-    std::unordered_map< int, std::pair< QString, QString > > fProviderColumnsByColumn;
+    std::unordered_map< QString, std::unordered_set< const CMediaData * > > fUserDataSeen;   // serverName -> media given user data by the current load
+    std::unordered_map< QString, std::unordered_set< const CMediaData * > > fUserDataGaps;   // serverName -> media asked for by ID in a sparse load
+    std::unordered_set< CSymbol > fProviderNames;
+    std::unordered_map< int, std::pair< QString, CSymbol > > fProviderColumnsByColumn;
     EDirSort fDirSort{ eNoSort };
 
     std::shared_ptr< CServerModel > fServerModel;
@@ -22,7 +22,6 @@
 
 #include "MediaServerData.h"
 #include "MediaData.h"
-#include <QVariant>
 
 QJsonObject SMediaServerData::toJson() const
 {
@@ -30,10 +29,10 @@ QJsonObject SMediaServerData::toJson() const
     obj[ "IsFavorite" ] = fIsFavorite;
     obj[ "Played" ] = fPlayed;
     obj[ "PlayCount" ] = static_cast< qlonglong >( fPlayCount );
-    if ( fLastPlayedDate.isNull() )
+    if ( fLastPlayedMSecs == NEmbyJSON::sNullMSecs )
         obj[ "LastPlayedDate" ] = QJsonValue::Null;
     else
-        obj[ "LastPlayedDate" ] = fLastPlayedDate.toUTC().toString( Qt::ISODateWithMs );
+        obj[ "LastPlayedDate" ] = NEmbyJSON::toString( fLastPlayedMSecs );
 
     auto ticks = static_cast< int64_t >( fPlaybackPositionTicks );
     if ( fPlaybackPositionTicks >= static_cast< uint64_t >( std::numeric_limits< qlonglong >::max() ) )
@@ -48,13 +47,27 @@ void SMediaServerData::loadUserDataFromJSON( const QJsonObject &userDataObj )
 {
     // qDebug() << QJsonDocument( userDataObj ).toJson();
 
-    fIsFavorite = userDataObj[ "IsFavorite" ].toBool();
-    fLastPlayedDate = userDataObj[ "LastPlayedDate" ].toVariant().toDateTime();
-    // qDebug() << fLastPlayedDate.toString();
-    // qDebug() << fLastPlayedDate;
-    fPlayCount = userDataObj[ "PlayCount" ].toVariant().toLongLong();
-    fPlaybackPositionTicks = userDataObj[ "PlaybackPositionTicks" ].toVariant().toLongLong();
-    fPlayed = userDataObj[ "Played" ].toVariant().toBool();
+    fIsFavorite = NEmbyJSON::toBool( userDataObj[ "IsFavorite" ] );
+    fLastPlayedMSecs = NEmbyJSON::toMSecsSinceEpoch( userDataObj[ "LastPlayedDate" ] );
+    fPlayCount = NEmbyJSON::toInt64( userDataObj[ "PlayCount" ] );
+    fPlaybackPositionTicks = NEmbyJSON::toInt64( userDataObj[ "PlaybackPositionTicks" ] );
+    fPlayed = NEmbyJSON::toBool( userDataObj[ "Played" ] );
+    fHidden = false;
+}
+
+void SMediaServerData::clearUserData()
+{
+    fIsFavorite = false;
+    fPlayed = false;
+    fLastPlayedMSecs = NEmbyJSON::sNullMSecs;
+    fPlayCount = 0;
+    fPlaybackPositionTicks = 0;
+}
+
+void SMediaServerData::hide()
+{
+    clearUserData();
+    fHidden = true;
 }
 
 bool SMediaServerData::isValid() const
@@ -83,6 +96,16 @@ QString SMediaServerData::playbackPosition() const
     return QString::number( playbackMS );
 }
 
+QDateTime SMediaServerData::lastPlayedDate() const
+{
+    return NEmbyJSON::toDateTime( fLastPlayedMSecs );
+}
+
+void SMediaServerData::setLastPlayedDate( const QDateTime &dateTime )
+{
+    fLastPlayedMSecs = NEmbyJSON::fromDateTime( dateTime );
+}
+
 QTime SMediaServerData::playbackPositionTime() const
 {
     auto playbackMS = playbackPositionMSecs();
@@ -107,8 +130,8 @@ bool SMediaServerData::userDataEqual( const SMediaServerData &rhs ) const
     auto equal = true;
     equal = equal && fIsFavorite == rhs.fIsFavorite;
     equal = equal && fPlayed == rhs.fPlayed;
-    if ( !fLastPlayedDate.isNull() && !rhs.fLastPlayedDate.isNull() )
-        equal = equal && fLastPlayedDate == rhs.fLastPlayedDate;
+    if ( ( fLastPlayedMSecs != NEmbyJSON::sNullMSecs ) && ( rhs.fLastPlayedMSecs != NEmbyJSON::sNullMSecs ) )
+        equal = equal && fLastPlayedMSecs == rhs.fLastPlayedMSecs;
     equal = equal && fPlayCount == rhs.fPlayCount;
     equal = equal && fPlaybackPositionTicks == rhs.fPlaybackPositionTicks;
     return equal;
@@ -23,6 +23,8 @@
 #ifndef __MEDIAUSERDATA_H
 #define __MEDIAUSERDATA_H
 //
+#include "EmbyJSON.h"
+
 #include <QString>
 #include <QDateTime>
 #include <cstdint>
@@ -33,13 +35,16 @@ struct SMediaServerData
     QString fMediaID;
     bool fIsFavorite{ false };
     bool fPlayed{ false };
-    QDateTime fLastPlayedDate;
-    uint64_t fPlayCount;
-    uint64_t fPlaybackPositionTicks;   // 1 tick = 10000 ms
+    int64_t fLastPlayedMSecs{ NEmbyJSON::sNullMSecs };   // UTC msecs since the epoch
+    uint64_t fPlayCount{ 0 };
+    uint64_t fPlaybackPositionTicks{ 0 };   // 1 tick = 10000 ms
 
     uint64_t playbackPositionMSecs() const;
     void setPlaybackPositionMSecs( uint64_t msecs );
 
+    QDateTime lastPlayedDate() const;   // built on demand, only the display needs a QDateTime
+    void setLastPlayedDate( const QDateTime &dateTime );
+
     QTime playbackPositionTime() const;
     void setPlaybackPosition( const QTime &time );
 
@@ -49,9 +54,12 @@ struct SMediaServerData
 
     QJsonObject toJson() const;
     void loadUserDataFromJSON( const QJsonObject &userDataObj );
+    void clearUserData();   // back to never played, the media ID is kept
+    void hide();   // cleared and hidden until user data is loaded again
 
     bool isValid() const;
     bool fBeenLoaded{ false };
+    bool fHidden{ false };   // the current user can not see the media on this server, the entry is only kept for the other users of a shared catalog
 };
 
 bool operator==( const SMediaServerData &lhs, const SMediaServerData &rhs );
@@ -1,240 +1,338 @@
 #include "MergeMedia.h"
 #include "MediaData.h"
 #include "ProgressSystem.h"
+#include "ServerModel.h"
 
 #include <QString>
 
+#include <algorithm>
 #include <map>
-#include <optional>
 
 #include <QDebug>
 
-using TMediaIDToMediaData = std::map< QString, std::shared_ptr< CMediaData > >;
-
-void CMergeMedia::addMediaInfo( const QString &serverName, std::shared_ptr< CMediaData > mediaData )
+void CMergeMedia::addMediaInfo( const QString &serverName, const std::shared_ptr< CMediaData > &mediaData )
 {
-    fMediaMap[ serverName ][ mediaData->getMediaID( serverName ) ] = mediaData;
-
-    auto &&providers = mediaData->getProviders( true );
-    for ( auto &&ii : providers )
-    {
-        fProviderSearchMap[ serverName ][ ii.first ][ ii.second ] = mediaData;
-    }
+    auto serverNum = fServerModel->getServerPos( serverName );
+    fMediaIndex.insert( serverNum, CMediaID( mediaData->getMediaID( serverNum ) ), mediaData );
+    if ( fMerged )
+        fPendingMedia.push_back( mediaData );
 }
 
 void CMergeMedia::removeMedia( const QString &serverName, const std::shared_ptr< CMediaData > &mediaData )
 {
-    auto pos = fMediaMap.find( serverName );
-    if ( pos != fMediaMap.end() )
-    {
-        auto pos2 = ( *pos ).second.find( mediaData->getMediaID( serverName ) );
-        ( *pos ).second.erase( pos2 );
-    }
-
-    auto &&providers = mediaData->getProviders( true );
-    for ( auto &&ii : providers )
-    {
-        auto pos = fProviderSearchMap.find( serverName );
-        if ( pos != fProviderSearchMap.end() )
-        {
-            auto pos2 = ( *pos ).second.find( ii.first );
-            if ( pos2 != ( *pos ).second.end() )
-            {
-                auto pos3 = ( *pos2 ).second.find( ii.second );
-                if ( pos3 != ( *pos2 ).second.end() )
-                    ( *pos2 ).second.erase( pos3 );
-                if ( ( *pos2 ).second.empty() )
-                {
-                    ( *pos ).second.erase( pos2 );
-                }
-            }
-            if ( ( *pos ).second.empty() )
-            {
-                fProviderSearchMap.erase( serverName );
-            }
-        }
-    }
+    auto serverNum = fServerModel->getServerPos( serverName );
+    fMediaIndex.erase( serverNum, CMediaID( mediaData->getMediaID( serverNum ) ) );
+    if ( fMerged )
+        fPendingRemovals.push_back( mediaData );
 }
 
 bool CMergeMedia::merge( std::shared_ptr< CProgressSystem > progressSystem )
 {
     progressSystem->resetProgress();
     progressSystem->setTitle( QObject::tr( "Merging media data" ) );
-    size_t total = 0;
-    for ( auto &&ii : fMediaMap )
-    {
-        total += ii.second.size();
-    }
-    progressSystem->setMaximum( static_cast< int >( total * 3 ) );
 
-    for ( auto &&ii = fMediaMap.begin(); ii != fMediaMap.end(); ++ii )
+    fChanges = SMergeChanges();
+    auto aOK = fMerged ? mergeChanged( progressSystem ) : mergeAll( progressSystem );
+    if ( !aOK )
+        clear();
+    return aOK;
+}
+
+// Media joins the merged media from an earlier server that shares the most provider ids with it, the per server
+// majority vote the provider search maps made.  A merged media holds one media per server and two merged media are
+// never joined, so an id that different titles share ( a box set, or a wrong id ) does not pull them together.
+// Every media is visited once and each of its keys is one lookup
+bool CMergeMedia::mergeAll( std::shared_ptr< CProgressSystem > progressSystem )
+{
+    struct SNode
+    {
+        int fServerNum{ -1 };
+        CMediaID fMediaID;
+        std::shared_ptr< CMediaData > fMediaData;
+    };
+
+    std::vector< SNode > nodes;
+    nodes.reserve( fMediaIndex.size() );
+    fMediaIndex.forEach(
+        [ &nodes ]( int serverNum, const CMediaID &mediaID, const std::shared_ptr< CMediaData > &mediaData )
+        {
+            if ( mediaData )
+                nodes.push_back( { serverNum, mediaID, mediaData } );
+        } );
+    // the first server's media is the one the others merge into
+    std::sort( nodes.begin(), nodes.end(), []( const SNode &lhs, const SNode &rhs ) { return std::make_pair( lhs.fServerNum, lhs.fMediaID.value() ) < std::make_pair( rhs.fServerNum, rhs.fMediaID.value() ); } );
+    progressSystem->setMaximum( static_cast< int >( nodes.size() ) );
+
+    std::vector< std::shared_ptr< CMediaData > > groups;   // the merged media
+    std::vector< std::unordered_map< CProviderIDs::TValue, int > > groupForKey;   // provider symbol -> provider ID -> first group with the key
+    std::vector< std::pair< int, int > > votes;   // group -> keys shared with the media
+    for ( auto &&node : nodes )
     {
         if ( progressSystem->wasCanceled() )
             break;
+        progressSystem->incProgress();
 
-        for ( auto jj = ii; jj != fMediaMap.end(); ++jj )
+        votes.clear();
+        node.fMediaData->forEachProviderKey(
+            true,
+            [ & ]( const CSymbol &providerName, CProviderIDs::TValue providerID )
+            {
+                if ( !providerID || ( providerName.id() >= groupForKey.size() ) )
+                    return;
+
+                auto &&idMap = groupForKey[ providerName.id() ];
+                auto pos = idMap.find( providerID );
+                if ( pos == idMap.end() )
+                    return;
+
+                auto &&mergedMedia = groups[ ( *pos ).second ];
+                if ( ( mergedMedia == node.fMediaData ) || !mergedMedia->getMediaID( node.fServerNum ).isEmpty() )
+                    return;
+
+                auto vote = std::find_if( votes.begin(), votes.end(), [ &pos ]( const std::pair< int, int > &ii ) { return ii.first == ( *pos ).second; } );
+                if ( vote == votes.end() )
+                    votes.emplace_back( ( *pos ).second, 1 );
+                else
+                    ( *vote ).second++;
+            } );
+
+        // ties go to the media from the earliest server
+        int group = -1;
+        int maxVotes = 0;
+        for ( auto &&ii : votes )
         {
-            if ( ii == jj )
-                continue;
-
-            merge( ( *ii ), ( *jj ), progressSystem );
-            if ( progressSystem->wasCanceled() )
-                break;
+            if ( ( ii.second > maxVotes ) || ( ( ii.second == maxVotes ) && ( ii.first < group ) ) )
+            {
+                group = ii.first;
+                maxVotes = ii.second;
+            }
+        }
 
-            merge( ( *jj ), ( *ii ), progressSystem );
-            if ( progressSystem->wasCanceled() )
-                break;
+        if ( group == -1 )
+        {
+            group = static_cast< int >( groups.size() );
+            groups.push_back( node.fMediaData );
+        }
+        else
+        {
+            auto &&mergedMedia = groups[ group ];
+            mergedMedia->updateFromOther( node.fServerNum, node.fMediaData );
+            fMediaIndex.insert( node.fServerNum, node.fMediaID, mergedMedia );
         }
-    }
 
-    fProviderSearchMap.clear();
+        node.fMediaData->forEachProviderKey(
+            true,
+            [ &groupForKey, group ]( const CSymbol &providerName, CProviderIDs::TValue providerID )
+            {
+                if ( !providerID )
+                    return;
+
+                if ( providerName.id() >= groupForKey.size() )
+                    groupForKey.resize( providerName.id() + 1 );
+                groupForKey[ providerName.id() ].emplace( providerID, group );
+            } );
+    }
 
     if ( progressSystem->wasCanceled() )
-        clear();
-    return !progressSystem->wasCanceled();
+        return false;
+
+    fMediaIndex.forEach(
+        [ this ]( int /*serverNum*/, const CMediaID & /*mediaID*/, const std::shared_ptr< CMediaData > &mediaData )
+        {
+            if ( mediaData && fMergedMedia.insert( mediaData ).second )
+                indexMedia( mediaData, mediaData );
+        } );
+    fMerged = true;
+    return true;
 }
 
-void CMergeMedia::merge( std::pair< const QString, TMediaIDToMediaData > &lhs, std::pair< const QString, TMediaIDToMediaData > &rhs, std::shared_ptr< CProgressSystem > progressSystem )
+// only the media added or removed since the last merge are linked against the live key index,
+// the media that are not touched keep their merged state
+bool CMergeMedia::mergeChanged( std::shared_ptr< CProgressSystem > progressSystem )
 {
-    // qDebug() << lhs.first << rhs.first;
+    progressSystem->setMaximum( static_cast< int >( fPendingRemovals.size() + fPendingMedia.size() ) );
 
-    merge( lhs, progressSystem );
-    merge( rhs, progressSystem );
-}
+    for ( auto &&ii : fPendingRemovals )
+    {
+        progressSystem->incProgress();
+        if ( !fMergedMedia.count( ii ) || isOnAnyServer( ii ) )
+            continue;
 
-void CMergeMedia::merge( std::pair< const QString, TMediaIDToMediaData > &mapData, std::shared_ptr< CProgressSystem > progressSystem )
-{
-    // qDebug() << mapData.first;
-    std::unordered_map< std::shared_ptr< CMediaData >, std::shared_ptr< CMediaData > > replacementMap;
-    for ( auto &&ii : mapData.second )
+        unindexMedia( ii );
+        fMergedMedia.erase( ii );
+        fChanges.fRemoved.insert( ii );
+    }
+    fPendingRemovals.clear();
+
+    std::unordered_set< std::shared_ptr< CMediaData > > absorbed;
+    for ( auto &&ii : fPendingMedia )
     {
         if ( progressSystem->wasCanceled() )
             break;
-
         progressSystem->incProgress();
-        auto mediaData = ii.second;
-        if ( !mediaData )
-            continue;
 
-        auto mediaProviders = mediaData->getProviders( true );
-        auto myMappedMedia = findMediaForProviders( mapData.first, mediaProviders );
-        if ( myMappedMedia && ( myMappedMedia != mediaData ) )
-        {
-            replacementMap[ mediaData ] = myMappedMedia;
-            continue;
-        }
+        linkMedia( ii, absorbed );
+    }
+    fPendingMedia.clear();
 
-        for ( auto &&ii : fProviderSearchMap )
-        {
-            if ( ii.first == mapData.first )
-                continue;
+    return !progressSystem->wasCanceled();
+}
 
-            auto otherData = findMediaForProviders( ii.first, mediaProviders );
-            if ( otherData != mediaData )
-                setMediaForProviders( ii.first, mediaProviders, mediaData );
+void CMergeMedia::linkMedia( const std::shared_ptr< CMediaData > &mediaData, std::unordered_set< std::shared_ptr< CMediaData > > &absorbed )
+{
+    if ( !mediaData || absorbed.count( mediaData ) )
+        return;
+
+    // the same vote as mergeAll, against the merged media in the key index
+    std::vector< std::pair< std::shared_ptr< CMediaData >, int > > votes;
+    mediaData->forEachProviderKey(
+        true,
+        [ & ]( const CSymbol &providerName, CProviderIDs::TValue providerID )
+        {
+            if ( !providerID )
+                return;
+
+            auto &&idMap = mediaForProvider( providerName );
+            auto pos = idMap.find( providerID );
+            if ( ( pos == idMap.end() ) || ( ( *pos ).second == mediaData ) || onSameServer( ( *pos ).second, mediaData ) )
+                return;
+
+            auto vote = std::find_if( votes.begin(), votes.end(), [ &pos ]( const std::pair< std::shared_ptr< CMediaData >, int > &ii ) { return ii.first == ( *pos ).second; } );
+            if ( vote == votes.end() )
+                votes.emplace_back( ( *pos ).second, 1 );
+            else
+                ( *vote ).second++;
+        } );
+
+    std::shared_ptr< CMediaData > mergedMedia;
+    int maxVotes = 0;
+    for ( auto &&ii : votes )
+    {
+        if ( ii.second > maxVotes )
+        {
+            mergedMedia = ii.first;
+            maxVotes = ii.second;
         }
     }
-    for ( auto &&ii : replacementMap )
-    {
-        auto currMediaID = ii.first->getMediaID( mapData.first );
-        auto pos = mapData.second.find( currMediaID );
-        mapData.second.erase( pos );
 
-        ii.second->updateFromOther( mapData.first, ii.first );
-        mapData.second[ currMediaID ] = ii.second;
+    if ( !mergedMedia )
+    {
+        indexMedia( mediaData, mediaData );
+        if ( fMergedMedia.insert( mediaData ).second )
+            fChanges.fAdded.insert( mediaData );
+        else if ( !fChanges.fAdded.count( mediaData ) )
+            fChanges.fChanged.insert( mediaData );
+        return;
     }
+
+    absorbMedia( mergedMedia, mediaData );
+    absorbed.insert( mediaData );
+    if ( !fChanges.fAdded.count( mergedMedia ) )
+        fChanges.fChanged.insert( mergedMedia );
 }
 
-QStringList CMergeMedia::getOtherServers( const QString &serverName ) const
+// moves every server's data for the media onto the merged media
+void CMergeMedia::absorbMedia( const std::shared_ptr< CMediaData > &mergedMedia, const std::shared_ptr< CMediaData > &mediaData )
 {
-    QStringList otherServers;
-    for ( auto &&ii : fProviderSearchMap )
+    for ( int ii = 0; ii < fServerModel->serverCnt(); ++ii )
     {
-        if ( ii.first != serverName )
-            otherServers << ii.first;
+        auto mediaID = CMediaID( mediaData->getMediaID( ii ) );
+        if ( !mediaID.isValid() || ( fMediaIndex.find( ii, mediaID ) != mediaData ) )
+            continue;
+
+        mergedMedia->updateFromOther( ii, mediaData );
+        fMediaIndex.insert( ii, mediaID, mergedMedia );
     }
-    return otherServers;
-}
 
-void CMergeMedia::clear()
-{
-    fMediaMap.clear();
-    fProviderSearchMap.clear();
+    unindexMedia( mediaData );
+    indexMedia( mediaData, mergedMedia );
+
+    fChanges.fChanged.erase( mediaData );
+    if ( fChanges.fAdded.erase( mediaData ) == 0 && fMergedMedia.count( mediaData ) )
+        fChanges.fRemoved.insert( mediaData );
+    fMergedMedia.erase( mediaData );
 }
 
-std::pair< std::unordered_set< std::shared_ptr< CMediaData > >, std::map< QString, TMediaIDToMediaData > > CMergeMedia::getMergedData( std::shared_ptr< CProgressSystem > progressSystem ) const
+// a merged media holds one media per server
+bool CMergeMedia::onSameServer( const std::shared_ptr< CMediaData > &lhs, const std::shared_ptr< CMediaData > &rhs ) const
 {
-    std::unordered_set< std::shared_ptr< CMediaData > > allMedia;
-
-    for ( auto &&ii : fMediaMap )
+    for ( int ii = 0; ii < fServerModel->serverCnt(); ++ii )
     {
-        for ( auto &&jj : ii.second )
-        {
-            allMedia.insert( jj.second );
-            progressSystem->incProgress();
-        }
+        auto mediaID = CMediaID( rhs->getMediaID( ii ) );
+        if ( mediaID.isValid() && ( fMediaIndex.find( ii, mediaID ) == rhs ) && !lhs->getMediaID( ii ).isEmpty() )
+            return true;
     }
-
-    return { allMedia, fMediaMap };
+    return false;
 }
 
-std::shared_ptr< CMediaData > CMergeMedia::findMediaForProviders( const QString &serverName, const std::map< QString, QString > &providerIDs ) const
+bool CMergeMedia::isOnAnyServer( const std::shared_ptr< CMediaData > &mediaData ) const
 {
-    auto pos = fProviderSearchMap.find( serverName );
-    if ( pos == fProviderSearchMap.end() )
-        return {};
-
-    std::map< std::shared_ptr< CMediaData >, int > mapCount;
-
-    for ( auto &&ii : providerIDs )
+    for ( int ii = 0; ii < fServerModel->serverCnt(); ++ii )
     {
-        if ( ii.second.isEmpty() )
-            continue;
-        auto currMedia = findMediaForProvider( ( *pos ).second, ii.first, ii.second );
-        if ( !currMedia )
-            continue;
-
-        mapCount[ currMedia ]++;
+        auto mediaID = CMediaID( mediaData->getMediaID( ii ) );
+        if ( mediaID.isValid() && ( fMediaIndex.find( ii, mediaID ) == mediaData ) )
+            return true;
     }
+    return false;
+}
 
-    if ( mapCount.size() == 1 )
-        return ( *mapCount.begin() ).first;
+std::unordered_map< CProviderIDs::TValue, std::shared_ptr< CMediaData > > &CMergeMedia::mediaForProvider( const CSymbol &providerName )
+{
+    if ( providerName.id() >= fMediaForKey.size() )
+        fMediaForKey.resize( providerName.id() + 1 );
+    return fMediaForKey[ providerName.id() ];
+}
 
-    int max = 0;
-    std::shared_ptr< CMediaData > retVal;
-    for ( auto &&ii : mapCount )
-    {
-        if ( ii.second > max )
+void CMergeMedia::indexMedia( const std::shared_ptr< CMediaData > &mediaData, const std::shared_ptr< CMediaData > &mergedMedia )
+{
+    mediaData->forEachProviderKey(
+        true,
+        [ this, &mergedMedia ]( const CSymbol &providerName, CProviderIDs::TValue providerID )
         {
-            max = ii.second;
-            retVal = ii.first;
-        }
-    }
-    return retVal;
+            if ( providerID )
+                mediaForProvider( providerName )[ providerID ] = mergedMedia;
+        } );
 }
 
-std::shared_ptr< CMediaData > CMergeMedia::findMediaForProvider( const std::unordered_map< QString, std::unordered_map< QString, std::shared_ptr< CMediaData > > > &map, const QString &provider, const QString &id ) const
+void CMergeMedia::unindexMedia( const std::shared_ptr< CMediaData > &mediaData )
 {
-    auto pos = map.find( provider );
-    if ( pos == map.end() )
-        return {};
-
-    auto pos2 = ( *pos ).second.find( id );
-    if ( pos2 == ( *pos ).second.end() )
-        return {};
-    return ( *pos2 ).second;
+    mediaData->forEachProviderKey(
+        true,
+        [ this, &mediaData ]( const CSymbol &providerName, CProviderIDs::TValue providerID )
+        {
+            if ( !providerID )
+                return;
+
+            auto &&idMap = mediaForProvider( providerName );
+            auto pos = idMap.find( providerID );
+            if ( ( pos != idMap.end() ) && ( ( *pos ).second == mediaData ) )
+                idMap.erase( pos );
+        } );
 }
 
-void CMergeMedia::setMediaForProviders( const QString &serverName, const std::map< QString, QString > &providerIDs, std::shared_ptr< CMediaData > mediaData )
+void CMergeMedia::clear()
 {
-    auto pos = fProviderSearchMap.find( serverName );
-    if ( pos == fProviderSearchMap.end() )
-        pos = fProviderSearchMap.insert( std::make_pair( serverName, std::unordered_map< QString, std::unordered_map< QString, std::shared_ptr< CMediaData > > >() ) ).first;
+    fMediaIndex.clear();
+    fMerged = false;
+    fMergedMedia.clear();
+    fMediaForKey.clear();
+    fPendingMedia.clear();
+    fPendingRemovals.clear();
+    fChanges = SMergeChanges();
+}
 
-    for ( auto &&ii : providerIDs )
-    {
-        if ( ii.second.isEmpty() )
-            continue;
-        ( *pos ).second[ ii.first ][ ii.second ] = mediaData;
-    }
+std::shared_ptr< CMediaData > CMergeMedia::findMedia( const QString &serverName, const QString &mediaID ) const
+{
+    return fMediaIndex.find( fServerModel->getServerPos( serverName ), CMediaID( mediaID ) );
+}
+
+void CMergeMedia::forEachMediaOnServer( const QString &serverName, std::function< void( const std::shared_ptr< CMediaData > &mediaData ) > func ) const
+{
+    auto serverNum = fServerModel->getServerPos( serverName );
+    fMediaIndex.forEach(
+        [ serverNum, &func ]( int currServerNum, const CMediaID & /*mediaID*/, const std::shared_ptr< CMediaData > &mediaData )
+        {
+            if ( currServerNum == serverNum )
+                func( mediaData );
+        } );
 }
@@ -1,45 +1,71 @@
 #ifndef __MERGEMEDIA_H
 #define __MERGEMEDIA_H
 
+#include "MediaIndex.h"
+#include "ProviderIDs.h"
 #include "SABUtils/HashUtils.h"
 #include <QString>
+#include <functional>
 #include <memory>
-#include <map>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 class CMediaData;
-using TMediaIDToMediaData = std::map< QString, std::shared_ptr< CMediaData > >;
 
 class CProgressSystem;
+class CServerModel;
+
+// what an incremental merge changed, in terms of the merged media
+struct SMergeChanges
+{
+    std::unordered_set< std::shared_ptr< CMediaData > > fAdded;   // merged media that did not exist before the merge
+    std::unordered_set< std::shared_ptr< CMediaData > > fChanged;   // existing merged media that picked up data
+    std::unordered_set< std::shared_ptr< CMediaData > > fRemoved;   // existing merged media that were merged away or removed from every server
+};
+
 class CMergeMedia
 {
 public:
-    CMergeMedia(){};
+    CMergeMedia( std::shared_ptr< CServerModel > serverModel ) :
+        fServerModel( serverModel ){};
     ~CMergeMedia(){};
 
-    void addMediaInfo( const QString &serverName, std::shared_ptr< CMediaData > mediaData );
+    void addMediaInfo( const QString &serverName, const std::shared_ptr< CMediaData > &mediaData );
     void removeMedia( const QString &serverName, const std::shared_ptr< CMediaData > &mediaData );
 
+    // once a full merge has run, later merges only link the media added or removed since the previous merge
+    bool isMerged() const { return fMerged; }
     bool merge( std::shared_ptr< CProgressSystem > progressSystem );
+    const SMergeChanges &lastChanges() const { return fChanges; }
     void clear();
 
-    std::pair< std::unordered_set< std::shared_ptr< CMediaData > >, std::map< QString, TMediaIDToMediaData > > getMergedData( std::shared_ptr< CProgressSystem > progressSystem ) const;
+    // the merge system owns the media, readers get references rather than copies
+    const std::unordered_set< std::shared_ptr< CMediaData > > &mergedMedia() const { return fMergedMedia; }
+    std::shared_ptr< CMediaData > findMedia( const QString &serverName, const QString &mediaID ) const;
+    void forEachMediaOnServer( const QString &serverName, std::function< void( const std::shared_ptr< CMediaData > &mediaData ) > func ) const;
 
 private:
-    void merge( std::pair< const QString, TMediaIDToMediaData > &lhs, std::pair< const QString, TMediaIDToMediaData > &rhs, std::shared_ptr< CProgressSystem > progressSystem );
-    void merge( std::pair< const QString, TMediaIDToMediaData > &mapData, std::shared_ptr< CProgressSystem > progressSystem );
-
-    QStringList getOtherServers( const QString &serverName ) const;
+    bool mergeAll( std::shared_ptr< CProgressSystem > progressSystem );
+    bool mergeChanged( std::shared_ptr< CProgressSystem > progressSystem );
 
-    std::shared_ptr< CMediaData > findMediaForProviders( const QString &serverName, const std::map< QString, QString > &providerIDs ) const;
-    std::shared_ptr< CMediaData > findMediaForProvider( const std::unordered_map< QString, std::unordered_map< QString, std::shared_ptr< CMediaData > > > &map, const QString &provider, const QString &id ) const;
-    void setMediaForProviders( const QString &serverName, const std::map< QString, QString > &providerIDs, std::shared_ptr< CMediaData > mediaData );
+    std::unordered_map< CProviderIDs::TValue, std::shared_ptr< CMediaData > > &mediaForProvider( const CSymbol &providerName );
+    void indexMedia( const std::shared_ptr< CMediaData > &mediaData, const std::shared_ptr< CMediaData > &mergedMedia );
+    void unindexMedia( const std::shared_ptr< CMediaData > &mediaData );
+    void linkMedia( const std::shared_ptr< CMediaData > &mediaData, std::unordered_set< std::shared_ptr< CMediaData > > &absorbed );
+    void absorbMedia( const std::shared_ptr< CMediaData > &mergedMedia, const std::shared_ptr< CMediaData > &mediaData );
+    bool onSameServer( const std::shared_ptr< CMediaData > &lhs, const std::shared_ptr< CMediaData > &rhs ) const;
+    bool isOnAnyServer( const std::shared_ptr< CMediaData > &mediaData ) const;
 
-    std::map< QString, TMediaIDToMediaData > fMediaMap;   // serverName -> mediaID -> mediaData
+    std::shared_ptr< CServerModel > fServerModel;
+    CMediaIndex fMediaIndex;   // (server position, mediaID) -> mediaData
 
-    // provider name -> provider ID -> mediaData
-    std::map< QString, std::unordered_map< QString, std::unordered_map< QString, std::shared_ptr< CMediaData > > > > fProviderSearchMap;   // servername -> provider name, to map of id to mediadata
+    bool fMerged{ false };
+    std::unordered_set< std::shared_ptr< CMediaData > > fMergedMedia;
+    std::vector< std::unordered_map< CProviderIDs::TValue, std::shared_ptr< CMediaData > > > fMediaForKey;   // provider symbol -> provider ID -> merged media
+    std::vector< std::shared_ptr< CMediaData > > fPendingMedia;   // added since the last merge
+    std::vector< std::shared_ptr< CMediaData > > fPendingRemovals;   // removed since the last merge
+    SMergeChanges fChanges;
 };
 
 #endif
@@ -0,0 +1,143 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "ProviderIDs.h"
+
+// packed values hold the number in the low bits, the digit count above it so leading zeros survive,
+// and a flag for the "tt" prefix.  Interned values hold the symbol id under the top bit
+static constexpr uint64_t sInternedBit = 1ULL << 63;
+static constexpr uint64_t sPrefixBit = 1ULL << 62;
+static constexpr int sDigitsShift = 56;
+static constexpr uint64_t sNumberMask = ( 1ULL << sDigitsShift ) - 1;
+static constexpr int sMaxDigits = 16;   // 10^16 - 1 fits in the number bits
+
+CProviderIDs::TValue CProviderIDs::encode( const QString &providerID )
+{
+    if ( providerID.isEmpty() )
+        return 0;
+
+    int start = 0;
+    if ( ( providerID.length() > 2 ) && ( providerID[ 0 ] == 't' ) && ( providerID[ 1 ] == 't' ) )
+        start = 2;
+
+    auto numDigits = providerID.length() - start;
+    bool isPacked = numDigits <= sMaxDigits;
+    uint64_t number = 0;
+    for ( int ii = start; isPacked && ( ii < providerID.length() ); ++ii )
+    {
+        auto ch = providerID[ ii ];
+        if ( ( ch < '0' ) || ( ch > '9' ) )
+            isPacked = false;
+        else
+            number = ( number * 10 ) + ( ch.unicode() - '0' );
+    }
+
+    if ( !isPacked )
+        return sInternedBit | CSymbol( providerID ).id();
+
+    auto retVal = number | ( static_cast< uint64_t >( numDigits ) << sDigitsShift );
+    if ( start )
+        retVal |= sPrefixBit;
+    return retVal;
+}
+
+QString CProviderIDs::decode( TValue value )
+{
+    if ( !value )
+        return {};
+
+    if ( ( value & sInternedBit ) != 0 )
+        return CSymbol::fromID( static_cast< uint32_t >( value & ~sInternedBit ) ).toString();
+
+    auto numDigits = static_cast< int >( ( value & ~sPrefixBit ) >> sDigitsShift );
+    auto retVal = QString::number( value & sNumberMask ).rightJustified( numDigits, '0' );
+    if ( ( value & sPrefixBit ) != 0 )
+        retVal.prepend( "tt" );
+    return retVal;
+}
+
+const CSymbol &CProviderIDs::knownProvider( size_t slot )
+{
+    static const std::array< CSymbol, sNumKnown > sKnown = { CSymbol( "Imdb" ), CSymbol( "Tmdb" ), CSymbol( "Tvdb" ) };
+    return sKnown[ slot ];
+}
+
+int CProviderIDs::knownSlot( const CSymbol &providerName )
+{
+    for ( size_t ii = 0; ii < sNumKnown; ++ii )
+    {
+        if ( knownProvider( ii ) == providerName )
+            return static_cast< int >( ii );
+    }
+    return -1;
+}
+
+void CProviderIDs::set( const CSymbol &providerName, const QString &providerID )
+{
+    auto value = encode( providerID );
+
+    auto slot = knownSlot( providerName );
+    if ( slot >= 0 )
+    {
+        fKnown[ slot ] = value;
+        return;
+    }
+
+    for ( auto pos = fOther.begin(); pos != fOther.end(); ++pos )
+    {
+        if ( ( *pos ).first != providerName )
+            continue;
+
+        if ( value )
+            ( *pos ).second = value;
+        else
+            fOther.erase( pos );
+        return;
+    }
+
+    if ( value )
+        fOther.emplace_back( providerName, value );
+}
+
+CProviderIDs::TValue CProviderIDs::value( const CSymbol &providerName ) const
+{
+    auto slot = knownSlot( providerName );
+    if ( slot >= 0 )
+        return fKnown[ slot ];
+
+    for ( auto &&ii : fOther )
+    {
+        if ( ii.first == providerName )
+            return ii.second;
+    }
+    return 0;
+}
+
+bool CProviderIDs::empty() const
+{
+    for ( auto &&ii : fKnown )
+    {
+        if ( ii )
+            return false;
+    }
+    return fOther.empty();
+}
@@ -0,0 +1,72 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __PROVIDERIDS_H
+#define __PROVIDERIDS_H
+
+#include "Symbol.h"
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// The provider ids for a media item.  The common providers get a fixed slot and anything else
+// goes in a short overflow list.  Each id is kept as a single value, ids that are all digits
+// (with imdb's "tt" prefix allowed) are packed into the value, any other id is interned
+class CProviderIDs
+{
+public:
+    using TValue = uint64_t;   // 0 is no id
+
+    static TValue encode( const QString &providerID );
+    static QString decode( TValue value );
+
+    void set( const CSymbol &providerName, const QString &providerID );   // an empty id removes the provider
+    TValue value( const CSymbol &providerName ) const;
+    QString get( const CSymbol &providerName ) const { return decode( value( providerName ) ); }
+    bool has( const CSymbol &providerName ) const { return value( providerName ) != 0; }
+    bool empty() const;
+
+    // func( const CSymbol &providerName, TValue value ), only providers with an id are visited
+    template< typename TFunc >
+    void forEach( TFunc func ) const
+    {
+        for ( size_t ii = 0; ii < fKnown.size(); ++ii )
+        {
+            if ( fKnown[ ii ] )
+                func( knownProvider( ii ), fKnown[ ii ] );
+        }
+        for ( auto &&ii : fOther )
+            func( ii.first, ii.second );
+    }
+
+private:
+    static constexpr size_t sNumKnown = 3;
+    static const CSymbol &knownProvider( size_t slot );
+    static int knownSlot( const CSymbol &providerName );
+
+    std::array< TValue, sNumKnown > fKnown{};
+    std::vector< std::pair< CSymbol, TValue > > fOther;
+};
+
+#endif
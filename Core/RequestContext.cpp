@@ -0,0 +1,71 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "RequestContext.h"
+
+void SRequestContext::clear()
+{
+    fServerName.clear();
+    fServerIndex = -1;
+    fHostName.clear();
+    fRequestType = ERequestType::eNone;
+    fOperation.reset();
+    fID.clear();
+    fNameAndID = {};
+    fIDs.clear();
+    fStartIndex = -1;
+    fLimit = 0;
+    fMutationIndex = -1;
+    fStreamTicket = 0;
+    fReply = nullptr;
+    fItemsReceived = 0;
+    fItemsLoaded = 0;
+    fQueuedMSecs = 0;
+    fSentMSecs = 0;
+}
+
+SRequestContext *CRequestContextPool::acquire()
+{
+    if ( fFree.empty() )
+    {
+        fSlabs.push_back( std::make_unique< SRequestContext[] >( kSlabSize ) );
+        auto &&slab = fSlabs.back();
+        fFree.reserve( fFree.size() + kSlabSize );
+        for ( size_t ii = kSlabSize; ii > 0; --ii )
+            fFree.push_back( &slab[ ii - 1 ] );
+    }
+
+    auto retVal = fFree.back();
+    fFree.pop_back();
+    fInUse++;
+    return retVal;
+}
+
+void CRequestContextPool::release( SRequestContext *context )
+{
+    if ( !context )
+        return;
+
+    context->clear();
+    fFree.push_back( context );
+    fInUse--;
+}
@@ -0,0 +1,84 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __REQUESTCONTEXT_H
+#define __REQUESTCONTEXT_H
+
+#include "SyncSystem.h"
+#include "SyncOperation.h"
+
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+// everything needed to handle a reply, filled in when the request is made
+// and attached to the reply once it is sent
+struct SRequestContext
+{
+    void clear();
+    bool isMediaListPage() const { return fStartIndex >= 0; }
+
+    QString fServerName;
+    int fServerIndex{ -1 };   // position in the server model
+    QString fHostName;   // key for the per host request counts
+    ERequestType fRequestType{ ERequestType::eNone };
+    std::shared_ptr< CSyncOperation > fOperation;   // the operation waiting on this request, if any
+
+    // payload, which members are used depends on the request type
+    QString fID;   // media ID, user ID or icon type
+    std::pair< QString, QString > fNameAndID;   // collection or folder name and ID
+    QStringList fIDs;   // batched media reloads
+    int fStartIndex{ -1 };   // media list page, -1 when the list is not paged
+    int fLimit{ 0 };
+    int fMutationIndex{ -1 };   // the sync plan change the request was made for
+
+    // Items responses that are read while they download
+    quint64 fStreamTicket{ 0 };   // 0 when the response is not streamed
+    QNetworkReply *fReply{ nullptr };   // while the response is downloading, reading is resumed once the parser catches up
+    int fItemsReceived{ 0 };
+    int fItemsLoaded{ 0 };   // not counting extras or items past the max
+
+    qint64 fQueuedMSecs{ 0 };
+    qint64 fSentMSecs{ 0 };
+};
+
+// contexts are allocated in slabs and recycled, a sync creates thousands of short lived requests
+class CRequestContextPool
+{
+public:
+    SRequestContext *acquire();
+    void release( SRequestContext *context );
+
+    size_t inUse() const { return fInUse; }
+    size_t capacity() const { return fSlabs.size() * kSlabSize; }
+
+private:
+    static constexpr size_t kSlabSize = 64;
+    std::vector< std::unique_ptr< SRequestContext[] > > fSlabs;
+    std::vector< SRequestContext * > fFree;
+    size_t fInUse{ 0 };
+};
+
+#endif
@@ -0,0 +1,223 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "RequestScheduler.h"
+#include "RequestContext.h"
+
+#include <QNetworkReply>
+
+#include <algorithm>
+
+ERequestPriority priorityForRequest( ERequestType requestType )
+{
+    switch ( requestType )
+    {
+        case ERequestType::eNone:
+        case ERequestType::eGetServerInfo:
+        case ERequestType::eGetServerHomePage:
+        case ERequestType::eGetUsers:
+        case ERequestType::eGetUser:
+        case ERequestType::eTestServer:
+        case ERequestType::eDeleteConnectedID:
+        case ERequestType::eSetConnectedID:
+        case ERequestType::eUpdateUserData:
+            return ERequestPriority::eInteractive;
+        case ERequestType::eGetMediaList:
+        case ERequestType::eGetUserDataList:
+        case ERequestType::eReloadMediaData:
+        case ERequestType::eGetMissingEpisodes:
+        case ERequestType::eGetMissingTVDBid:
+        case ERequestType::eGetAllMovies:
+        case ERequestType::eGetAllCollections:
+        case ERequestType::eGetAllCollectionsEx:
+        case ERequestType::eGetCollection:
+            return ERequestPriority::eCatalogRead;
+        case ERequestType::eUpdateUserMediaData:
+        case ERequestType::eUpdateFavorite:
+        case ERequestType::eCreateCollection:
+            return ERequestPriority::eWrite;
+        case ERequestType::eGetServerIcon:
+        case ERequestType::eGetUserAvatar:
+        case ERequestType::eSetUserAvatar:
+            return ERequestPriority::eBackground;
+    }
+    return ERequestPriority::eInteractive;
+}
+
+QString toString( ERequestPriority priority )
+{
+    switch ( priority )
+    {
+        case ERequestPriority::eInteractive:
+            return "Interactive";
+        case ERequestPriority::eCatalogRead:
+            return "Catalog Read";
+        case ERequestPriority::eWrite:
+            return "Write";
+        case ERequestPriority::eBackground:
+            return "Background";
+        default:
+            return {};
+    }
+}
+
+CRequestScheduler::CRequestScheduler( std::function< QNetworkReply *( const SPendingRequest &request ) > sendFunc ) :
+    fSendFunc( sendFunc )
+{
+}
+
+void CRequestScheduler::setMaxInFlightPerServer( int maxInFlight )
+{
+    maxInFlight = std::max( 1, maxInFlight );
+    if ( maxInFlight == fMaxInFlightPerServer )
+        return;
+
+    fMaxInFlightPerServer = maxInFlight;
+    sendNext();
+}
+
+void CRequestScheduler::enqueue( SPendingRequest &&request )
+{
+    auto priority = static_cast< size_t >( priorityForRequest( request.fContext->fRequestType ) );
+    auto &&serverQueue = fServers[ request.fContext->fServerName ];
+    serverQueue.fQueues[ priority ].push_back( std::move( request ) );
+    sendNext();
+}
+
+void CRequestScheduler::requestFinished( const QString &serverName )
+{
+    auto pos = fServers.find( serverName );
+    if ( pos == fServers.end() )
+        return;
+
+    if ( ( *pos ).second.fInFlight > 0 )
+        ( *pos ).second.fInFlight--;
+    sendNext();
+}
+
+void CRequestScheduler::sendNext()
+{
+    if ( fSending )   // the send function may enqueue, the outer loop picks those up
+        return;
+
+    fSending = true;
+    bool sentOne = true;
+    while ( sentOne )
+    {
+        sentOne = false;
+
+        // start with the server after the last one serviced
+        auto start = fServers.upper_bound( fLastServerSent );
+        for ( size_t ii = 0; ii < fServers.size(); ++ii )
+        {
+            if ( start == fServers.end() )
+                start = fServers.begin();
+            auto curr = start++;
+
+            auto &&serverQueue = ( *curr ).second;
+            if ( ( serverQueue.fInFlight >= fMaxInFlightPerServer ) || !serverQueue.hasQueued() )
+                continue;
+
+            auto request = serverQueue.takeNext();
+            fLastServerSent = ( *curr ).first;
+            if ( fSendFunc && fSendFunc( request ) )
+                serverQueue.fInFlight++;
+            sentOne = true;
+            break;
+        }
+    }
+    fSending = false;
+}
+
+std::list< SPendingRequest > CRequestScheduler::clear()
+{
+    std::list< SPendingRequest > retVal;
+    for ( auto &&ii : fServers )
+    {
+        while ( ii.second.hasQueued() )
+            retVal.push_back( ii.second.takeNext() );
+    }
+    return retVal;
+}
+
+bool CRequestScheduler::empty() const
+{
+    return queuedCount() == 0;
+}
+
+int CRequestScheduler::queuedCount() const
+{
+    int retVal = 0;
+    for ( auto &&ii : fServers )
+    {
+        for ( auto &&jj : ii.second.fQueues )
+            retVal += static_cast< int >( jj.size() );
+    }
+    return retVal;
+}
+
+int CRequestScheduler::queuedCount( const QString &serverName, ERequestPriority priority ) const
+{
+    auto pos = fServers.find( serverName );
+    if ( pos == fServers.end() )
+        return 0;
+    return static_cast< int >( ( *pos ).second.fQueues[ static_cast< size_t >( priority ) ].size() );
+}
+
+int CRequestScheduler::inFlightCount( const QString &serverName ) const
+{
+    auto pos = fServers.find( serverName );
+    if ( pos == fServers.end() )
+        return 0;
+    return ( *pos ).second.fInFlight;
+}
+
+std::list< QString > CRequestScheduler::servers() const
+{
+    std::list< QString > retVal;
+    for ( auto &&ii : fServers )
+        retVal.push_back( ii.first );
+    return retVal;
+}
+
+bool CRequestScheduler::SServerQueue::hasQueued() const
+{
+    for ( auto &&ii : fQueues )
+    {
+        if ( !ii.empty() )
+            return true;
+    }
+    return false;
+}
+
+SPendingRequest CRequestScheduler::SServerQueue::takeNext()
+{
+    for ( auto &&ii : fQueues )
+    {
+        if ( ii.empty() )
+            continue;
+        auto retVal = std::move( ii.front() );
+        ii.pop_front();
+        return retVal;
+    }
+    return {};
+}
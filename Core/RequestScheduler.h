@@ -0,0 +1,103 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __REQUESTSCHEDULER_H
+#define __REQUESTSCHEDULER_H
+
+#include "SyncSystem.h"
+
+#include <QString>
+#include <QByteArray>
+#include <QNetworkRequest>
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+
+class QNetworkReply;
+struct SRequestContext;
+
+enum class ERequestPriority
+{
+    eInteractive,   // user driven, server info, users, connect ids
+    eCatalogRead,   // media lists, collections and media reloads
+    eWrite,   // play state and favorite updates
+    eBackground,   // avatars and icons
+    eNumPriorities
+};
+
+ERequestPriority priorityForRequest( ERequestType requestType );
+QString toString( ERequestPriority priority );
+
+struct SPendingRequest
+{
+    QNetworkRequest fRequest;
+    ENetworkRequestType fNetworkRequestType{ ENetworkRequestType::eGet };
+    QByteArray fData;
+    SRequestContext *fContext{ nullptr };   // owned by the sync system's context pool
+};
+
+// Holds every request until its server has a free slot.  Each server has its own
+// in-flight limit, within a server higher priority requests are sent first, and
+// servers are serviced round robin so one busy server can not starve the others.
+class CRequestScheduler
+{
+public:
+    CRequestScheduler( std::function< QNetworkReply *( const SPendingRequest &request ) > sendFunc );
+
+    void setMaxInFlightPerServer( int maxInFlight );
+    int maxInFlightPerServer() const { return fMaxInFlightPerServer; }
+
+    void enqueue( SPendingRequest &&request );
+    void requestFinished( const QString &serverName );   // frees the servers slot and sends the next request(s)
+
+    std::list< SPendingRequest > clear();   // returns the requests that were never sent
+
+    bool empty() const;
+    int queuedCount() const;
+    int queuedCount( const QString &serverName, ERequestPriority priority ) const;
+    int inFlightCount( const QString &serverName ) const;
+
+    std::list< QString > servers() const;
+
+private:
+    void sendNext();
+
+    struct SServerQueue
+    {
+        std::array< std::deque< SPendingRequest >, static_cast< size_t >( ERequestPriority::eNumPriorities ) > fQueues;
+        int fInFlight{ 0 };
+
+        bool hasQueued() const;
+        SPendingRequest takeNext();
+    };
+
+    std::function< QNetworkReply *( const SPendingRequest &request ) > fSendFunc;
+    std::map< QString, SServerQueue > fServers;   // serverName -> queue
+    QString fLastServerSent;   // round robin position
+    int fMaxInFlightPerServer{ 6 };
+    bool fSending{ false };
+};
+
+#endif
@@ -0,0 +1,149 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "ResponseParser.h"
+
+#include <QThread>
+
+#include <algorithm>
+
+CItemsStreamReader *CResponseParserWorker::reader( quint64 ticket )
+{
+    auto &&reader = fReaders[ ticket ];
+    if ( !reader )
+        reader = std::make_unique< CItemsStreamReader >( [ this ]( const QJsonObject &item ) { fBatch.append( item ); } );
+    return reader.get();
+}
+
+void CResponseParserWorker::slotStreamData( quint64 ticket, const QByteArray &data )
+{
+    // acknowledged even without items, the bytes read let the reply be read further
+    reader( ticket )->addData( data );
+    emit sigStreamItems( ticket, fBatch, data.size() );
+    fBatch = QJsonArray();
+}
+
+void CResponseParserWorker::slotEndStream( quint64 ticket )
+{
+    auto streamReader = reader( ticket );
+    auto aOK = streamReader->finish();
+    emit sigStreamFinished( ticket, streamReader->header(), streamReader->isItemList(), aOK ? QString() : streamReader->errorString() );
+    fReaders.erase( ticket );
+}
+
+void CResponseParserWorker::slotCancelStream( quint64 ticket )
+{
+    fReaders.erase( ticket );
+}
+
+CResponseParser::CResponseParser( QObject *parent ) :
+    QObject( parent )
+{
+    fThread = new QThread( this );
+    fThread->setObjectName( "ResponseParser" );
+
+    fWorker = new CResponseParserWorker;
+    fWorker->moveToThread( fThread );
+    connect( fThread, &QThread::finished, fWorker, &QObject::deleteLater );
+
+    connect( this, &CResponseParser::sigStreamData, fWorker, &CResponseParserWorker::slotStreamData, Qt::QueuedConnection );
+    connect( this, &CResponseParser::sigEndStream, fWorker, &CResponseParserWorker::slotEndStream, Qt::QueuedConnection );
+    connect( this, &CResponseParser::sigCancelStream, fWorker, &CResponseParserWorker::slotCancelStream, Qt::QueuedConnection );
+    connect( fWorker, &CResponseParserWorker::sigStreamItems, this, &CResponseParser::slotStreamItems, Qt::QueuedConnection );
+    connect( fWorker, &CResponseParserWorker::sigStreamFinished, this, &CResponseParser::slotStreamFinished, Qt::QueuedConnection );
+
+    fThread->start();
+}
+
+CResponseParser::~CResponseParser()
+{
+    fThread->quit();
+    fThread->wait();
+}
+
+quint64 CResponseParser::beginStream( TItemsFunc itemsFunc )
+{
+    auto ticket = fNextTicket++;
+    fStreams[ ticket ].fItemsFunc = itemsFunc;
+    return ticket;
+}
+
+void CResponseParser::addStreamData( quint64 ticket, const QByteArray &data )
+{
+    auto pos = fStreams.find( ticket );
+    if ( data.isEmpty() || ( pos == fStreams.end() ) )
+        return;
+    ( *pos ).second.fPendingBytes += data.size();
+    emit sigStreamData( ticket, data );
+}
+
+void CResponseParser::endStream( quint64 ticket, TFinishedFunc finishedFunc )
+{
+    auto pos = fStreams.find( ticket );
+    if ( pos == fStreams.end() )
+        return;
+
+    ( *pos ).second.fFinishedFunc = finishedFunc;
+    emit sigEndStream( ticket );
+}
+
+void CResponseParser::cancelStream( quint64 ticket )
+{
+    auto pos = fStreams.find( ticket );
+    if ( pos == fStreams.end() )
+        return;
+
+    fStreams.erase( pos );
+    emit sigCancelStream( ticket );
+}
+
+qint64 CResponseParser::pendingBytes( quint64 ticket ) const
+{
+    auto pos = fStreams.find( ticket );
+    if ( pos == fStreams.end() )
+        return 0;
+    return ( *pos ).second.fPendingBytes;
+}
+
+void CResponseParser::slotStreamItems( quint64 ticket, const QJsonArray &items, qint64 bytesRead )
+{
+    auto pos = fStreams.find( ticket );
+    if ( pos == fStreams.end() )
+        return;
+
+    ( *pos ).second.fPendingBytes = std::max< qint64 >( 0, ( *pos ).second.fPendingBytes - bytesRead );
+
+    if ( ( *pos ).second.fItemsFunc )
+        ( *pos ).second.fItemsFunc( ticket, items );
+}
+
+void CResponseParser::slotStreamFinished( quint64 ticket, const QJsonObject &header, bool isItemList, const QString &errorMsg )
+{
+    auto pos = fStreams.find( ticket );
+    if ( pos == fStreams.end() )
+        return;
+
+    auto finishedFunc = std::move( ( *pos ).second.fFinishedFunc );
+    fStreams.erase( pos );
+    if ( finishedFunc )
+        finishedFunc( ticket, header, isItemList, errorMsg );
+}
@@ -0,0 +1,107 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __RESPONSEPARSER_H
+#define __RESPONSEPARSER_H
+
+#include "ItemsStreamReader.h"
+
+#include <QObject>
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+class QThread;
+
+class CResponseParserWorker : public QObject
+{
+    Q_OBJECT
+public Q_SLOTS:
+    void slotStreamData( quint64 ticket, const QByteArray &data );
+    void slotEndStream( quint64 ticket );
+    void slotCancelStream( quint64 ticket );
+Q_SIGNALS:
+    void sigStreamItems( quint64 ticket, const QJsonArray &items, qint64 bytesRead );   // sent for every chunk, items may be empty
+    void sigStreamFinished( quint64 ticket, const QJsonObject &header, bool isItemList, const QString &errorMsg );
+
+private:
+    CItemsStreamReader *reader( quint64 ticket );
+
+    std::unordered_map< quint64, std::unique_ptr< CItemsStreamReader > > fReaders;   // ticket -> reader
+    QJsonArray fBatch;   // items read from the current chunk
+};
+
+// Reads Items responses on a worker thread while they download.  The data is
+// handed over chunk by chunk, the items of each chunk come back through a
+// queued connection and the callbacks run on the thread that owns the parser,
+// so the models are only ever touched there.  Only the parsing leaves that
+// thread, the network requests, CMediaModel::loadMedia and the merge still run
+// on it, so a large merge still holds up the GUI while it runs.
+class CResponseParser : public QObject
+{
+    Q_OBJECT
+public:
+    // the ticket is passed back so the caller looks up its own state, rather than holding on to it in the callback.
+    // The items func is called once the worker read a chunk, with no items when the chunk did not complete one
+    using TItemsFunc = std::function< void( quint64 ticket, const QJsonArray &items ) >;
+    using TFinishedFunc = std::function< void( quint64 ticket, const QJsonObject &header, bool isItemList, const QString &errorMsg ) >;   // errorMsg is empty on success
+
+    CResponseParser( QObject *parent = nullptr );
+    ~CResponseParser();
+
+    quint64 beginStream( TItemsFunc itemsFunc );
+    void addStreamData( quint64 ticket, const QByteArray &data );
+    void endStream( quint64 ticket, TFinishedFunc finishedFunc );
+    void cancelStream( quint64 ticket );   // nothing more is reported for the ticket
+    qint64 pendingBytes( quint64 ticket ) const;   // handed to the worker but not read yet, the caller stops adding data past its limit
+
+    bool isParsing() const { return !fStreams.empty(); }
+
+Q_SIGNALS:
+    void sigStreamData( quint64 ticket, const QByteArray &data );
+    void sigEndStream( quint64 ticket );
+    void sigCancelStream( quint64 ticket );
+
+private Q_SLOTS:
+    void slotStreamItems( quint64 ticket, const QJsonArray &items, qint64 bytesRead );
+    void slotStreamFinished( quint64 ticket, const QJsonObject &header, bool isItemList, const QString &errorMsg );
+
+private:
+    struct SStream
+    {
+        TItemsFunc fItemsFunc;
+        TFinishedFunc fFinishedFunc;
+        qint64 fPendingBytes{ 0 };
+    };
+
+    QThread *fThread{ nullptr };
+    CResponseParserWorker *fWorker{ nullptr };
+    quint64 fNextTicket{ 1 };   // 0 is never a ticket
+    std::unordered_map< quint64, SStream > fStreams;   // ticket -> callbacks
+};
+
+#endif
@@ -157,6 +157,14 @@ bool CSettings::load( const QString &fileName, std::function< void( const QStrin
     setMediaSourceColor( getValue( json.object(), "MediaSourceColor", "yellow" ).toString() );
     setMediaDestColor( getValue( json.object(), "MediaDestColor", "yellow" ).toString() );
     setMaxItems( getValue( json.object(), "MaxItems", -1 ).toInt() );
+    setMediaPageSize( getValue( json.object(), "MediaPageSize", 1000 ).toInt() );
+    setMaxPagesInFlight( getValue( json.object(), "MaxPagesInFlight", 4 ).toInt() );
+    setMaxRequestsPerServer( getValue( json.object(), "MaxRequestsPerServer", 6 ).toInt() );
+    setDeltaSync( getValue( json.object(), "DeltaSync", false ).toBool() );
+    setDeltaSyncFullRefreshRuns( getValue( json.object(), "DeltaSyncFullRefreshRuns", 24 ).toInt() );
+    setSharedCatalog( getValue( json.object(), "SharedCatalog", false ).toBool() );
+    setCatalogRefreshMinutes( getValue( json.object(), "CatalogRefreshMinutes", 24 * 60 ).toInt() );
+    setSparseUserData( getValue( json.object(), "SparseUserData", false ).toBool() );
     setSyncAudio( getValue( json.object(), "SyncAudio", true ).toBool() );
     setSyncVideo( getValue( json.object(), "SyncVideo", true ).toBool() );
     setSyncEpisode( getValue( json.object(), "SyncEpisode", true ).toBool() );
@@ -226,6 +234,14 @@ bool CSettings::save( std::function< void( const QString &title, const QString &
     root[ "MediaSourceColor" ] = mediaSourceColor().name();
     root[ "MediaDestColor" ] = mediaDestColor().name();
     root[ "MaxItems" ] = maxItems();
+    root[ "MediaPageSize" ] = mediaPageSize();
+    root[ "MaxPagesInFlight" ] = maxPagesInFlight();
+    root[ "MaxRequestsPerServer" ] = maxRequestsPerServer();
+    root[ "DeltaSync" ] = deltaSync();
+    root[ "DeltaSyncFullRefreshRuns" ] = deltaSyncFullRefreshRuns();
+    root[ "SharedCatalog" ] = sharedCatalog();
+    root[ "CatalogRefreshMinutes" ] = catalogRefreshMinutes();
+    root[ "SparseUserData" ] = sparseUserData();
 
     root[ "SyncAudio" ] = syncAudio();
     root[ "SyncVideo" ] = syncVideo();
@@ -349,6 +365,46 @@ void CSettings::setMaxItems( int maxItems )
     updateValue( fMaxItems, maxItems );
 }
 
+void CSettings::setMediaPageSize( int pageSize )
+{
+    updateValue( fMediaPageSize, pageSize );
+}
+
+void CSettings::setMaxPagesInFlight( int maxPages )
+{
+    updateValue( fMaxPagesInFlight, maxPages );
+}
+
+void CSettings::setMaxRequestsPerServer( int maxRequests )
+{
+    updateValue( fMaxRequestsPerServer, maxRequests );
+}
+
+void CSettings::setDeltaSync( bool value )
+{
+    updateValue( fDeltaSync, value );
+}
+
+void CSettings::setDeltaSyncFullRefreshRuns( int runs )
+{
+    updateValue( fDeltaSyncFullRefreshRuns, runs );
+}
+
+void CSettings::setSharedCatalog( bool value )
+{
+    updateValue( fSharedCatalog, value );
+}
+
+void CSettings::setCatalogRefreshMinutes( int minutes )
+{
+    updateValue( fCatalogRefreshMinutes, minutes );
+}
+
+void CSettings::setSparseUserData( bool value )
+{
+    updateValue( fSparseUserData, value );
+}
+
 void CSettings::setSyncAudio( bool value )
 {
     updateValue( fSyncAudio, value );
@@ -89,6 +89,30 @@ public:
     int maxItems() const { return fMaxItems; }
     void setMaxItems( int maxItems );
 
+    int mediaPageSize() const { return fMediaPageSize; }   // <= 0 means load the users media in a single request
+    void setMediaPageSize( int pageSize );
+
+    int maxPagesInFlight() const { return fMaxPagesInFlight; }
+    void setMaxPagesInFlight( int maxPages );
+
+    int maxRequestsPerServer() const { return fMaxRequestsPerServer; }
+    void setMaxRequestsPerServer( int maxRequests );
+
+    bool deltaSync() const { return fDeltaSync; }   // only fetch media whose user data changed since the last sync
+    void setDeltaSync( bool value );
+
+    int deltaSyncFullRefreshRuns() const { return fDeltaSyncFullRefreshRuns; }   // every Nth run is a full refresh, <= 1 means always full
+    void setDeltaSyncFullRefreshRuns( int runs );
+
+    bool sharedCatalog() const { return fSharedCatalog; }   // the CLI loads the media once and only the play state for each further user
+    void setSharedCatalog( bool value );
+
+    int catalogRefreshMinutes() const { return fCatalogRefreshMinutes; }   // the daemon reloads the shared catalog once it is this old, <= 0 means every cycle
+    void setCatalogRefreshMinutes( int minutes );
+
+    bool sparseUserData() const { return fSparseUserData; }   // a shared catalog only fetches the played, favorite and resumable items
+    void setSparseUserData( bool value );
+
     bool syncAudio() const { return fSyncAudio; }
     void setSyncAudio( bool value );
 
@@ -171,6 +195,14 @@ private:
     QColor fMediaDestColor{ "yellow" };
     QColor fMediaDataMissingColor{ "red" };
     int fMaxItems{ -1 };
+    int fMediaPageSize{ 1000 };
+    int fMaxPagesInFlight{ 4 };
+    int fMaxRequestsPerServer{ 6 };
+    bool fDeltaSync{ false };
+    int fDeltaSyncFullRefreshRuns{ 24 };
+    bool fSharedCatalog{ false };
+    int fCatalogRefreshMinutes{ 24 * 60 };
+    bool fSparseUserData{ false };
 
     bool fOnlyShowSyncableUsers{ true };
 
@@ -0,0 +1,104 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Symbol.h"
+#include "SABUtils/HashUtils.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+    // the strings are stored in fixed size chunks that never move, so a symbol can be read back
+    // without taking the lock, only interning a new string locks
+    struct SSymbolTable
+    {
+        static constexpr uint32_t sChunkBits = 12;
+        static constexpr uint32_t sChunkSize = 1 << sChunkBits;
+        static constexpr uint32_t sMaxChunks = 4096;
+
+        SSymbolTable()
+        {
+            fChunks[ 0 ].reset( new QString[ sChunkSize ] );
+            fIDs[ QString() ] = 0;
+            fCount = 1;
+        }
+
+        const QString &value( uint32_t id ) const { return fChunks[ id >> sChunkBits ][ id & ( sChunkSize - 1 ) ]; }
+
+        uint32_t intern( const QString &value )
+        {
+            std::lock_guard< std::mutex > lock( fMutex );
+            auto pos = fIDs.find( value );
+            if ( pos != fIDs.end() )
+                return ( *pos ).second;
+
+            auto id = fCount.load();
+            Q_ASSERT( ( id >> sChunkBits ) < sMaxChunks );
+            auto &&chunk = fChunks[ id >> sChunkBits ];
+            if ( !chunk )
+                chunk.reset( new QString[ sChunkSize ] );
+            chunk[ id & ( sChunkSize - 1 ) ] = value;
+            fIDs[ value ] = id;
+            fCount = id + 1;
+            return id;
+        }
+
+        std::mutex fMutex;
+        std::unordered_map< QString, uint32_t > fIDs;
+        std::array< std::unique_ptr< QString[] >, sMaxChunks > fChunks;
+        std::atomic< uint32_t > fCount{ 0 };
+    };
+
+    SSymbolTable &symbolTable()
+    {
+        static SSymbolTable sSymbolTable;
+        return sSymbolTable;
+    }
+}
+
+CSymbol::CSymbol( const QString &value )
+{
+    if ( !value.isEmpty() )
+        fID = symbolTable().intern( value );
+}
+
+const QString &CSymbol::toString() const
+{
+    return symbolTable().value( fID );
+}
+
+uint32_t CSymbol::count()
+{
+    return symbolTable().fCount;
+}
+
+CSymbol CSymbol::fromID( uint32_t id )
+{
+    Q_ASSERT( id < count() );
+    CSymbol retVal;
+    retVal.fID = id;
+    return retVal;
+}
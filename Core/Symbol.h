@@ -0,0 +1,63 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __SYMBOL_H
+#define __SYMBOL_H
+
+#include <QString>
+
+#include <cstdint>
+#include <functional>
+
+// A process wide interned string.  Strings that repeat across the library (item types, series names,
+// provider names) are stored once, and compared and hashed as a small integer
+class CSymbol
+{
+public:
+    CSymbol() = default;   // the empty string
+    explicit CSymbol( const QString &value );
+
+    uint32_t id() const { return fID; }
+    bool isEmpty() const { return fID == 0; }
+    const QString &toString() const;
+
+    bool operator==( const CSymbol &rhs ) const { return fID == rhs.fID; }
+    bool operator!=( const CSymbol &rhs ) const { return fID != rhs.fID; }
+    bool operator<( const CSymbol &rhs ) const { return fID < rhs.fID; }   // interning order, not alphabetical
+
+    static uint32_t count();   // one past the largest id handed out so far
+    static CSymbol fromID( uint32_t id );   // id must have come from id()
+
+private:
+    uint32_t fID{ 0 };
+};
+
+namespace std
+{
+    template<>
+    struct hash< CSymbol >
+    {
+        size_t operator()( const CSymbol &symbol ) const { return symbol.id(); }
+    };
+}
+
+#endif
@@ -0,0 +1,73 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "SyncOperation.h"
+
+#include <utility>
+
+CSyncOperation::CSyncOperation( const QString &name, std::initializer_list< ERequestType > requestTypes, std::function< void( const CSyncOperation &operation ) > completedFunc ) :
+    fName( name ),
+    fRequestTypes( requestTypes ),
+    fCompletedFunc( completedFunc )
+{
+}
+
+void CSyncOperation::addRequest()
+{
+    fPending++;
+}
+
+void CSyncOperation::requestFinished( bool aOK )
+{
+    if ( fPending > 0 )
+        fPending--;
+    if ( !aOK )
+        fFailed = true;
+    checkFinished();
+}
+
+void CSyncOperation::seal()
+{
+    fSealed = true;
+    checkFinished();
+}
+
+void CSyncOperation::checkFinished()
+{
+    if ( fFinished || !fSealed || ( fPending > 0 ) )
+        return;
+
+    fFinished = true;
+    if ( fCompletedFunc )
+        fCompletedFunc( *this );
+}
+
+CSyncOperationScope::CSyncOperationScope( std::shared_ptr< CSyncOperation > &active, std::shared_ptr< CSyncOperation > operation ) :
+    fActive( active ),
+    fPrevious( std::exchange( active, operation ) )
+{
+}
+
+CSyncOperationScope::~CSyncOperationScope()
+{
+    fActive = fPrevious;
+}
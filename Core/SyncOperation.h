@@ -0,0 +1,78 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __SYNCOPERATION_H
+#define __SYNCOPERATION_H
+
+#include "SyncSystem.h"
+
+#include <QString>
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <set>
+
+// A unit of work such as "load the media for a user".  Every request of the
+// types it owns made while it is the active operation becomes its child,
+// and it completes the moment its last child finishes.
+class CSyncOperation
+{
+public:
+    CSyncOperation( const QString &name, std::initializer_list< ERequestType > requestTypes, std::function< void( const CSyncOperation &operation ) > completedFunc );
+
+    QString name() const { return fName; }
+    bool owns( ERequestType requestType ) const { return fRequestTypes.find( requestType ) != fRequestTypes.end(); }
+
+    void addRequest();
+    void requestFinished( bool aOK );
+    void seal();   // the initial requests have been made, completes now if none are pending
+
+    bool isFinished() const { return fFinished; }
+    bool failed() const { return fFailed; }
+    int pendingRequests() const { return fPending; }
+
+private:
+    void checkFinished();
+
+    QString fName;
+    std::set< ERequestType > fRequestTypes;
+    std::function< void( const CSyncOperation &operation ) > fCompletedFunc;
+    int fPending{ 0 };
+    bool fSealed{ false };
+    bool fFailed{ false };
+    bool fFinished{ false };
+};
+
+// makes an operation the active one for its lifetime
+class CSyncOperationScope
+{
+public:
+    CSyncOperationScope( std::shared_ptr< CSyncOperation > &active, std::shared_ptr< CSyncOperation > operation );
+    ~CSyncOperationScope();
+
+private:
+    std::shared_ptr< CSyncOperation > &fActive;
+    std::shared_ptr< CSyncOperation > fPrevious;
+};
+
+#endif
@@ -0,0 +1,210 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "SyncPlan.h"
+#include "MediaData.h"
+#include "MediaServerData.h"
+#include "ServerInfo.h"
+#include "ServerModel.h"
+#include "UserData.h"
+
+#include <QDateTime>
+#include <QJsonArray>
+
+#include <algorithm>
+
+QJsonObject SSyncMutation::toJson() const
+{
+    QJsonObject retVal;
+    retVal[ "Server" ] = fServerName;
+    retVal[ "MediaID" ] = fMediaID;
+    retVal[ "Name" ] = fMediaData ? fMediaData->name() : QString();
+    if ( fUpdateUserData && fNewData )
+        retVal[ "UserData" ] = fNewData->toJson();
+    if ( fFavorite.has_value() )
+        retVal[ "IsFavorite" ] = fFavorite.value();
+    return retVal;
+}
+
+CSyncPlan::CSyncPlan( std::shared_ptr< CServerModel > serverModel, std::shared_ptr< CUserData > user, const QString &selectedServer ) :
+    fServerModel( serverModel ),
+    fUser( user ),
+    fSelectedServer( selectedServer )
+{
+}
+
+void CSyncPlan::addMedia( const std::shared_ptr< CMediaData > &mediaData )
+{
+    if ( !mediaData || !fServerModel || !fUser || mediaData->validUserDataEqual() )
+        return;
+
+    for ( auto &&serverInfo : *fServerModel )
+    {
+        auto serverName = serverInfo->keyName();
+        auto needsUpdating = fSelectedServer.isEmpty() ? mediaData->needsUpdating( serverName ) : ( serverName != fSelectedServer );
+        if ( !needsUpdating )
+            continue;
+
+        auto currData = mediaData->serverData( mediaData->serverNum( serverName ) );
+        auto newData = fSelectedServer.isEmpty() ? mediaData->newestMediaData() : mediaData->userMediaData( fSelectedServer );
+        if ( !currData || !newData )
+            continue;
+
+        SSyncMutation mutation;
+        mutation.fServerName = serverName;
+        mutation.fMediaID = mediaData->getMediaID( serverName );
+        if ( mutation.fMediaID.isEmpty() || fUser->getUserID( serverName ).isEmpty() )
+            continue;
+
+        mutation.fMediaData = mediaData;
+        mutation.fNewData = newData;
+        mutation.fUpdateUserData = ( *currData != *newData );
+        if ( mediaData->isFavorite( serverName ) != newData->fIsFavorite )
+            mutation.fFavorite = newData->fIsFavorite;
+
+        if ( mutation.fUpdateUserData || mutation.fFavorite.has_value() )
+            fMutations.push_back( mutation );
+    }
+}
+
+void CSyncPlan::sort()
+{
+    std::stable_sort( fMutations.begin(), fMutations.end(), []( const SSyncMutation &lhs, const SSyncMutation &rhs ) { return std::make_pair( lhs.fServerName, lhs.fMediaData->name() ) < std::make_pair( rhs.fServerName, rhs.fMediaData->name() ); } );
+}
+
+QJsonObject CSyncPlan::toJson() const
+{
+    QJsonObject retVal;
+    retVal[ "User" ] = fUser ? fUser->allNames() : QString();
+    if ( !fSelectedServer.isEmpty() )
+        retVal[ "SelectedServer" ] = fSelectedServer;
+
+    QJsonArray mutations;
+    for ( auto &&ii : fMutations )
+        mutations.push_back( ii.toJson() );
+    retVal[ "Mutations" ] = mutations;
+    return retVal;
+}
+
+CSyncPlanExecutor::CSyncPlanExecutor( const CSyncPlan &plan, int maxPerServer, TIssueFunc issueFunc, TCompletedFunc completedFunc ) :
+    fPlan( plan ),
+    fMaxPerServer( std::max( maxPerServer, 1 ) ),
+    fIssueFunc( issueFunc ),
+    fCompletedFunc( completedFunc )
+{
+    fStates.resize( fPlan.size() );
+    for ( size_t ii = 0; ii < fPlan.size(); ++ii )
+        fQueued[ fPlan.mutation( ii ).fServerName ].push_back( ii );
+}
+
+void CSyncPlanExecutor::start()
+{
+    fStartMSecs = QDateTime::currentMSecsSinceEpoch();
+    fStarting = true;
+    for ( auto &&ii : fQueued )
+        issueNext( ii.first );
+    fStarting = false;
+    checkFinished();
+}
+
+void CSyncPlanExecutor::issueNext( const QString &serverName )
+{
+    // mutations that finish while being issued are picked up by this loop rather than recursing
+    if ( !fIssuing.insert( serverName ).second )
+        return;
+
+    auto &&queue = fQueued[ serverName ];
+    auto &&outstanding = fOutstanding[ serverName ];
+    while ( !queue.empty() && ( outstanding < fMaxPerServer ) )
+    {
+        auto index = queue.front();
+        queue.pop_front();
+        outstanding++;
+
+        auto numRequests = fIssueFunc ? fIssueFunc( index, fPlan.mutation( index ) ) : 0;
+        fRequestsMade += numRequests;
+
+        auto &&state = fStates[ index ];
+        state.fPending += numRequests;
+        if ( state.fPending <= 0 )
+        {
+            if ( numRequests == 0 )
+                state.fFailed = true;   // nothing could be sent for it
+            mutationFinished( index );
+        }
+    }
+    fIssuing.erase( serverName );
+}
+
+void CSyncPlanExecutor::requestFinished( size_t index, bool aOK )
+{
+    if ( index >= fStates.size() )
+        return;
+
+    auto &&state = fStates[ index ];
+    state.fPending--;
+    if ( !aOK )
+        state.fFailed = true;
+    if ( state.fPending == 0 )
+        mutationFinished( index );
+}
+
+void CSyncPlanExecutor::mutationFinished( size_t index )
+{
+    auto &&state = fStates[ index ];
+    if ( state.fDone )
+        return;
+
+    state.fDone = true;
+    fFinishedCount++;
+
+    auto &&serverName = fPlan.mutation( index ).fServerName;
+    fOutstanding[ serverName ]--;
+    issueNext( serverName );
+    checkFinished();
+}
+
+void CSyncPlanExecutor::checkFinished()
+{
+    if ( fFinished || fStarting || ( fFinishedCount < fPlan.size() ) )
+        return;
+
+    fFinished = true;
+    if ( fCompletedFunc )
+        fCompletedFunc( *this );
+}
+
+std::vector< size_t > CSyncPlanExecutor::failedMutations() const
+{
+    std::vector< size_t > retVal;
+    for ( size_t ii = 0; ii < fStates.size(); ++ii )
+    {
+        if ( fStates[ ii ].fFailed )
+            retVal.push_back( ii );
+    }
+    return retVal;
+}
+
+qint64 CSyncPlanExecutor::elapsedMSecs() const
+{
+    return QDateTime::currentMSecsSinceEpoch() - fStartMSecs;
+}
@@ -0,0 +1,130 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __SYNCPLAN_H
+#define __SYNCPLAN_H
+
+#include <QString>
+#include <QJsonObject>
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <vector>
+
+class CMediaData;
+class CServerModel;
+class CUserData;
+struct SMediaServerData;
+
+// one change to make on one server
+struct SSyncMutation
+{
+    QString fServerName;
+    QString fMediaID;
+    std::shared_ptr< CMediaData > fMediaData;
+    std::shared_ptr< SMediaServerData > fNewData;
+    bool fUpdateUserData{ false };   // the play state differs from fNewData
+    std::optional< bool > fFavorite;   // set when the favorite status changes
+
+    QJsonObject toJson() const;
+};
+
+// The changes a sync would make, decided up front so they can be inspected
+// ( --dry-run ) before any request is made.
+class CSyncPlan
+{
+public:
+    CSyncPlan() = default;
+    CSyncPlan( std::shared_ptr< CServerModel > serverModel, std::shared_ptr< CUserData > user, const QString &selectedServer );
+
+    void addMedia( const std::shared_ptr< CMediaData > &mediaData );   // adds the mutations needed to bring the media in sync
+    void sort();   // by server then name, so the same data always gives the same plan
+
+    QString selectedServer() const { return fSelectedServer; }
+    bool empty() const { return fMutations.empty(); }
+    size_t size() const { return fMutations.size(); }
+    const std::vector< SSyncMutation > &mutations() const { return fMutations; }
+    const SSyncMutation &mutation( size_t index ) const { return fMutations[ index ]; }
+
+    QJsonObject toJson() const;
+
+private:
+    std::shared_ptr< CServerModel > fServerModel;
+    std::shared_ptr< CUserData > fUser;
+    QString fSelectedServer;   // when set, the data on this server is copied to the others
+    std::vector< SSyncMutation > fMutations;
+};
+
+// Runs a plan with at most maxPerServer mutations outstanding on each server.
+// The issue function makes the requests for a mutation and returns how many it
+// made, each of them is reported back through requestFinished.
+class CSyncPlanExecutor
+{
+public:
+    using TIssueFunc = std::function< int( size_t index, const SSyncMutation &mutation ) >;
+    using TCompletedFunc = std::function< void( const CSyncPlanExecutor &executor ) >;
+
+    CSyncPlanExecutor( const CSyncPlan &plan, int maxPerServer, TIssueFunc issueFunc, TCompletedFunc completedFunc );
+
+    void start();
+    void requestFinished( size_t index, bool aOK );
+
+    const CSyncPlan &plan() const { return fPlan; }
+    bool isFinished() const { return fFinished; }
+    size_t finishedCount() const { return fFinishedCount; }
+    std::vector< size_t > failedMutations() const;
+    int requestsMade() const { return fRequestsMade; }
+    qint64 elapsedMSecs() const;
+
+private:
+    void issueNext( const QString &serverName );
+    void mutationFinished( size_t index );
+    void checkFinished();
+
+    struct SMutationState
+    {
+        int fPending{ 0 };   // negative while requests fail before the issue function returns
+        bool fFailed{ false };
+        bool fDone{ false };
+    };
+
+    CSyncPlan fPlan;
+    int fMaxPerServer{ 1 };
+    TIssueFunc fIssueFunc;
+    TCompletedFunc fCompletedFunc;
+
+    std::vector< SMutationState > fStates;
+    std::map< QString, std::deque< size_t > > fQueued;   // serverName -> mutations not started yet
+    std::map< QString, int > fOutstanding;   // serverName -> mutations started and not done
+    std::set< QString > fIssuing;   // servers whose queue is being issued
+    size_t fFinishedCount{ 0 };
+    int fRequestsMade{ 0 };
+    qint64 fStartMSecs{ 0 };
+    bool fStarting{ false };
+    bool fFinished{ false };
+};
+
+#endif
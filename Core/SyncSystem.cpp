@@ -29,6 +29,13 @@
 #include "MediaModel.h"
 #include "ServerModel.h"
 #include "CollectionsModel.h"
+#include "RequestScheduler.h"
+#include "RequestContext.h"
+#include "SyncOperation.h"
+#include "SyncPlan.h"
+#include "ResponseParser.h"
+#include "DeltaSyncState.h"
+#include "UserDataListener.h"
 
 #include "ServerInfo.h"
 #include "MediaData.h"
@@ -36,6 +43,9 @@
 #include "SABUtils/StringUtils.h"
 
 #include <unordered_set>
+#include <algorithm>
+#include <limits>
+#include <iterator>
 
 #include <QTimer>
 #include <QDebug>
@@ -52,6 +62,7 @@
 #include <QJsonObject>
 #include <QBuffer>
 #include <QUrlQuery>
+#include <QLocale>
 
 QString toString( ERequestType request )
 {
@@ -75,6 +86,8 @@ QString toString( ERequestType request )
             return "SetUserAvatar";
         case ERequestType::eGetMediaList:
             return "GetMediaList";
+        case ERequestType::eGetUserDataList:
+            return "GetUserDataList";
         case ERequestType::eReloadMediaData:
             return "ReloadMediaData";
         case ERequestType::eUpdateUserMediaData:
@@ -107,6 +120,28 @@ QString toString( ERequestType request )
     return {};
 }
 
+QString toString( ETool tool )
+{
+    switch ( tool )
+    {
+        case ETool::eNone:
+            return "None";
+        case ETool::ePlayState:
+            return "PlayState";
+        case ETool::eUserInfo:
+            return "UserInfo";
+        case ETool::eMissingEpisodes:
+            return "MissingEpisodes";
+        case ETool::eMissingTMDBId:
+            return "MissingTMDBId";
+        case ETool::eMissingMovies:
+            return "MissingMovies";
+        case ETool::eMissingCollections:
+            return "MissingCollections";
+    }
+    return {};
+}
+
 QString toString( EMsgType type )
 {
     switch ( type )
@@ -140,6 +175,9 @@ CSyncSystem::CSyncSystem( std::shared_ptr< CSettings > settings, std::shared_ptr
     fProgressSystem( new CProgressSystem )
 {
     fManager = new QNetworkAccessManager( this );
+    fRequestScheduler = std::make_unique< CRequestScheduler >( [ this ]( const SPendingRequest &request ) { return sendRequest( request ); } );
+    fRequestContextPool = std::make_unique< CRequestContextPool >();
+    fResponseParser = new CResponseParser( this );
 #if QT_VERSION > QT_VERSION_CHECK( 5, 14, 0 )
     fManager->setAutoDeleteReplies( true );
 #endif
@@ -152,6 +190,10 @@ CSyncSystem::CSyncSystem( std::shared_ptr< CSettings > settings, std::shared_ptr
     connect( fManager, &QNetworkAccessManager::finished, this, &CSyncSystem::slotRequestFinished );
 }
 
+CSyncSystem::~CSyncSystem()
+{
+}
+
 void CSyncSystem::setProcessNewMediaFunc( std::function< void( std::shared_ptr< CMediaData > userData ) > processNewMediaFunc )
 {
     fProcessNewMediaFunc = processNewMediaFunc;
@@ -169,7 +211,42 @@ void CSyncSystem::setProgressSystem( std::shared_ptr< CProgressSystem > funcs )
 
 void CSyncSystem::reset()
 {
-    fAttributes.clear();
+    // nothing started for the old data may keep running, every request is released the same way a failed one is
+    fPlanExecutor.reset();
+    fPendingReloads.clear();
+    fDeltaSyncRun = SDeltaSyncRun();
+
+    auto neverSent = fRequestScheduler->clear();
+    for ( auto &&ii : neverSent )
+        abandonRequest( ii.fContext );
+
+    // taken out of the map before the abort, so the finished signal of the reply is ignored
+    auto replyContexts = std::move( fReplyContexts );
+    fReplyContexts.clear();
+    std::list< SRequestContext * > contexts;
+    for ( auto &&ii : replyContexts )
+    {
+        disconnect( ii.first, nullptr, this, nullptr );
+        ii.first->abort();
+        contexts.push_back( ii.second );
+    }
+
+    // finished downloading, but the parser has not read all of the items yet
+    for ( auto &&ii : fStreamContexts )
+    {
+        if ( std::find( contexts.begin(), contexts.end(), ii.second ) == contexts.end() )
+            contexts.push_back( ii.second );
+    }
+
+    // releasing the context cancels its stream, so nothing reaches a context after it went back to the pool
+    for ( auto &&ii : contexts )
+    {
+        auto serverName = ii->fServerName;
+        abandonRequest( ii );
+        fRequestScheduler->requestFinished( serverName );
+    }
+    fMediaListPaging.clear();
+    fUserDataLists.clear();
 }
 
 void CSyncSystem::loadServerInfo()
@@ -207,12 +284,18 @@ void CSyncSystem::loadUsers()
     auto enabledServers = fServerModel->enabledServerCnt();
     fProgressSystem->setMaximum( enabledServers );
 
-    for ( auto &&serverInfo : *fServerModel )
-    {
-        if ( !serverInfo->isEnabled() )
-            continue;
-        requestGetUsers( serverInfo->keyName() );
-    }
+    auto operation = std::make_shared< CSyncOperation >( tr( "Load Users" ), std::initializer_list< ERequestType >{ ERequestType::eGetUsers }, [ this ]( const CSyncOperation & ) { emit sigLoadingUsersFinished(); } );
+    runOperation(
+        operation,
+        [ this ]()
+        {
+            for ( auto &&serverInfo : *fServerModel )
+            {
+                if ( !serverInfo->isEnabled() )
+                    continue;
+                requestGetUsers( serverInfo->keyName() );
+            }
+        } );
 }
 
 void CSyncSystem::loadUsersMedia( ETool tool, std::shared_ptr< CUserData > userData )
@@ -223,15 +306,149 @@ void CSyncSystem::loadUsersMedia( ETool tool, std::shared_ptr< CUserData > userD
     if ( !setCurrentUser( tool, userData ) )
         return;
 
-    fProgressSystem->setTitle( tr( "Loading Users Media" ) );
-    for ( auto &&serverInfo : *fServerModel )
+    if ( fSharedCatalog && fCatalogLoaded && ( tool == ETool::ePlayState ) )
     {
-        if ( !serverInfo->isEnabled() )
-            continue;
+        loadUserDataForCatalog( tool, userData );
+        return;
+    }
+
+    startDeltaSyncRun( tool );
+
+    // each user of the CLI is loaded on its own, media left from the previous user would keep that user's play state
+    // and a delta only reloads what changed
+    if ( fDeltaSyncAllowed && !fSharedCatalog )
+        fMediaModel->clear();
+
+    fProgressSystem->setTitle( tr( "Loading Users Media" ) );
+
+    auto operation = std::make_shared< CSyncOperation >(
+        tr( "Load Media for '%1'" ).arg( userData->allNames() ), std::initializer_list< ERequestType >{ ERequestType::eGetMediaList },
+        [ this, tool ]( const CSyncOperation &operation )
+        {
+            if ( fProgressSystem->wasCanceled() )
+                return;
+            if ( operation.failed() )
+            {
+                userMediaLoadFailed();
+                return;
+            }
+            if ( requestDeltaSyncCounterparts() )
+                return;
+
+            fCatalogLoaded = fSharedCatalog && ( tool == ETool::ePlayState );
+            fCatalogUser = fCatalogLoaded ? currUser().second : std::shared_ptr< CUserData >();
+            fProgressSystem->resetProgress();
+            slotMergeMedia( ERequestType::eGetMediaList );
+        } );
+    runOperation(
+        operation,
+        [ this ]()
+        {
+            for ( auto &&serverInfo : *fServerModel )
+            {
+                if ( !serverInfo->isEnabled() )
+                    continue;
+
+                emit sigAddToLog( EMsgType::eInfo, QString( "Loading media for '%1' on server '%2'" ).arg( currUser().second->userName( serverInfo->keyName() ) ).arg( serverInfo->displayName() ) );
+                requestGetMediaList( serverInfo->keyName() );
+            }
+        } );
+}
+
+// a partly loaded user is neither merged nor synced, sigProcessingFinished lets the CLI move on to the next user
+void CSyncSystem::userMediaLoadFailed()
+{
+    auto userName = currUser().second ? currUser().second->allNames() : QString();
+    emit sigAddToLog( EMsgType::eError, tr( "The media for '%1' could not be loaded from every server, nothing was synced" ).arg( userName ) );
+    fProgressSystem->resetProgress();
+    emit sigProcessingFinished( userName );
+}
+
+void CSyncSystem::loadUserDataForCatalog( ETool tool, std::shared_ptr< CUserData > userData )
+{
+    startDeltaSyncRun( tool );
+
+    fProgressSystem->setTitle( tr( "Loading Users Play State" ) );
+    fUserDataLists.clear();
+
+    // items this user sees that the catalog does not have are loaded in full as eGetMediaList requests
+    auto operation = std::make_shared< CSyncOperation >(
+        tr( "Load Play State for '%1'" ).arg( userData->allNames() ), std::initializer_list< ERequestType >{ ERequestType::eGetUserDataList, ERequestType::eGetMediaList },
+        [ this, tool, userData ]( const CSyncOperation &operation )
+        {
+            if ( fProgressSystem->wasCanceled() )
+                return;
+
+            if ( operation.failed() )
+            {
+                // the catalog still holds another users play state, it can not be synced from
+                emit sigAddToLog( EMsgType::eWarning, tr( "The play state for '%1' could not be loaded, reloading the full media list" ).arg( userData->allNames() ) );
+                invalidateSharedCatalog();
+                loadUsersMedia( tool, userData );
+                return;
+            }
+
+            fCatalogUser = userData;
+            fProgressSystem->resetProgress();
+            slotMergeMedia( ERequestType::eGetMediaList );
+        } );
+    runOperation(
+        operation,
+        [ this ]()
+        {
+            for ( auto &&serverInfo : *fServerModel )
+            {
+                if ( !serverInfo->isEnabled() )
+                    continue;
 
-        emit sigAddToLog( EMsgType::eInfo, QString( "Loading media for '%1' on server '%2'" ).arg( currUser().second->userName( serverInfo->keyName() ) ).arg( serverInfo->displayName() ) );
-        requestGetMediaList( serverInfo->keyName() );
+                emit sigAddToLog( EMsgType::eInfo, QString( "Loading play state for '%1' on server '%2'" ).arg( currUser().second->userName( serverInfo->keyName() ) ).arg( serverInfo->displayName() ) );
+                fMediaModel->beginUserDataLoad( serverInfo->keyName() );
+                requestGetUserDataList( serverInfo->keyName() );
+            }
+        } );
+}
+
+void CSyncSystem::runOperation( std::shared_ptr< CSyncOperation > operation, std::function< void() > makeRequests )
+{
+    {
+        CSyncOperationScope scope( fActiveOperation, operation );
+        makeRequests();
     }
+    operation->seal();
+}
+
+std::shared_ptr< CSyncOperation > CSyncSystem::newMediaOperation( const QString &name, ERequestType requestType )
+{
+    return std::make_shared< CSyncOperation >(
+        name, std::initializer_list< ERequestType >{ requestType },
+        [ this, requestType ]( const CSyncOperation &operation )
+        {
+            if ( operation.failed() )
+            {
+                switch ( requestType )
+                {
+                    case ERequestType::eGetMissingEpisodes:
+                        emit sigMissingEpisodesLoaded();
+                        break;
+                    case ERequestType::eGetMissingTVDBid:
+                        emit sigMissingTVDBidLoaded();
+                        break;
+                    case ERequestType::eGetAllMovies:
+                        emit sigAllMoviesLoaded();
+                        break;
+                    default:
+                        emit sigUserMediaLoaded();
+                        break;
+                }
+                return;
+            }
+
+            if ( fProgressSystem->wasCanceled() )
+                return;
+
+            fProgressSystem->resetProgress();
+            slotMergeMedia( requestType );
+        } );
 }
 
 bool CSyncSystem::setCurrentUser( ETool tool, std::shared_ptr< CUserData > userData, bool forSync )
@@ -278,7 +495,7 @@ bool CSyncSystem::loadMissingEpisodes( std::shared_ptr< CUserData > userData, st
         return false;
 
     emit sigAddToLog( EMsgType::eInfo, QString( "Loading Missing Episodes on server '%1' using admin user '%2'" ).arg( serverInfo->displayName() ).arg( userData->userName( serverInfo->keyName() ) ) );
-    requestMissingEpisodes( serverInfo->keyName(), minPremiereDate, maxPremiereDate );
+    runOperation( newMediaOperation( tr( "Load Missing Episodes" ), ERequestType::eGetMissingEpisodes ), [ this, serverInfo, minPremiereDate, maxPremiereDate ]() { requestMissingEpisodes( serverInfo->keyName(), minPremiereDate, maxPremiereDate ); } );
     return true;
 }
 
@@ -303,7 +520,7 @@ bool CSyncSystem::loadMissingTVDBid( std::shared_ptr< CUserData > userData, std:
         return false;
 
     emit sigAddToLog( EMsgType::eInfo, QString( "Loading Missing TVDBid on server '%1' using admin user '%2'" ).arg( serverInfo->displayName() ).arg( userData->userName( serverInfo->keyName() ) ) );
-    requestMissingTVDBid( serverInfo->keyName() );
+    runOperation( newMediaOperation( tr( "Load Missing TVDBid" ), ERequestType::eGetMissingTVDBid ), [ this, serverInfo ]() { requestMissingTVDBid( serverInfo->keyName() ); } );
     return true;
 }
 
@@ -328,7 +545,7 @@ bool CSyncSystem::loadAllMovies( std::shared_ptr< CUserData > userData, std::sha
         return false;
 
     emit sigAddToLog( EMsgType::eInfo, QString( "Loading All Movies on server '%1' using admin user '%2'" ).arg( serverInfo->displayName() ).arg( userData->userName( serverInfo->keyName() ) ) );
-    requestAllMovies( serverInfo->keyName() );
+    runOperation( newMediaOperation( tr( "Load All Movies" ), ERequestType::eGetAllMovies ), [ this, serverInfo ]() { requestAllMovies( serverInfo->keyName() ); } );
     return true;
 }
 
@@ -353,7 +570,17 @@ bool CSyncSystem::loadAllCollections( std::shared_ptr< CUserData > userData, std
         return false;
 
     emit sigAddToLog( EMsgType::eInfo, QString( "Loading All Collections on server '%1' using admin user '%2'" ).arg( serverInfo->displayName() ).arg( userData->userName( serverInfo->keyName() ) ) );
-    requestAllCollections( serverInfo->keyName() );
+    // the folder and collection requests are made as each level comes back and belong to the same operation
+    auto operation = std::make_shared< CSyncOperation >(
+        tr( "Load All Collections" ), std::initializer_list< ERequestType >{ ERequestType::eGetAllCollections, ERequestType::eGetAllCollectionsEx, ERequestType::eGetCollection },
+        [ this ]( const CSyncOperation & )
+        {
+            if ( fProgressSystem->wasCanceled() )
+                return;
+            fProgressSystem->resetProgress();
+            emit sigAllCollectionsLoaded();
+        } );
+    runOperation( operation, [ this, serverInfo ]() { requestAllCollections( serverInfo->keyName() ); } );
     return true;
 }
 
@@ -397,77 +624,79 @@ void CSyncSystem::selectiveProcessMedia( const QString &selectedServer )
 
     fProgressSystem->setTitle( title );
 
-    auto allMedia = fMediaModel->getAllMedia();
-    int cnt = 0;
-    for ( auto &&ii : allMedia )
+    executeSyncPlan( buildSyncPlan( selectedServer ) );
+}
+
+CSyncPlan CSyncSystem::buildSyncPlan( const QString &selectedServer ) const
+{
+    CSyncPlan retVal( fServerModel, currUser().second, selectedServer );
+    if ( !currUser().second )
+        return retVal;
+
+    for ( auto &&ii : fMediaModel->getAllMedia() )
     {
         if ( !ii || !ii->isValidForAllServers() )
             continue;
-        if ( ii->validUserDataEqual() )
-            continue;
-
-        cnt++;
+        retVal.addMedia( ii );
     }
+    retVal.sort();
+    return retVal;
+}
 
-    if ( cnt == 0 )
+void CSyncSystem::executeSyncPlan( const CSyncPlan &plan )
+{
+    if ( plan.empty() )
     {
         fProgressSystem->resetProgress();
-        emit sigProcessingFinished( currUser().second->userName( selectedServer ) );
+        finishDeltaSyncRun();
+        emit sigProcessingFinished( currUser().second->userName( plan.selectedServer() ) );
         return;
     }
 
-    fProgressSystem->setMaximum( static_cast< int >( cnt ) );
+    emit sigAddToLog( EMsgType::eInfo, tr( "Sync plan has %1 changes" ).arg( plan.size() ) );
+    fProgressSystem->setMaximum( static_cast< int >( plan.size() ) );
 
-    for ( auto &&ii : allMedia )
-    {
-        if ( !ii || !ii->isValidForAllServers() )
-            continue;
-        if ( ii->validUserDataEqual() )
-            continue;
+    fPlanExecutor = std::make_unique< CSyncPlanExecutor >(
+        plan, fSettings->maxRequestsPerServer(), [ this ]( size_t index, const SSyncMutation &mutation ) { return issueSyncMutation( index, mutation ); },
+        [ this ]( const CSyncPlanExecutor &executor ) { reportSyncPlanResults( executor ); } );
+    fPlanExecutor->start();
 
-        fProgressSystem->incProgress();
-        bool dataProcessed = processMedia( ii, selectedServer );
-        (void)dataProcessed;
+    // nothing could be sent
+    if ( fPlanExecutor->isFinished() && !isRunning() )
+    {
+        fProgressSystem->resetProgress();
+        finishDeltaSyncRun();
+        emit sigProcessingFinished( currUser().second->userName( plan.selectedServer() ) );
     }
 }
 
-bool CSyncSystem::processMedia( std::shared_ptr< CMediaData > mediaData, const QString &selectedServer )
+int CSyncSystem::issueSyncMutation( size_t index, const SSyncMutation &mutation )
 {
-    if ( !mediaData || mediaData->validUserDataEqual() )
-        return false;
+    fProgressSystem->incProgress();
 
-    if ( !currUser().second )
-        return false;
+    int retVal = 0;
+    if ( mutation.fUpdateUserData && requestUpdateUserDataForMedia( mutation.fServerName, mutation.fMediaData, mutation.fNewData, static_cast< int >( index ) ) )
+        retVal++;
 
-    /*
-        "UserData": {
-        "IsFavorite": false,
-        "LastPlayedDate": "2022-01-15T20:28:39.0000000Z",
-        "PlayCount": 1,
-        "PlaybackPositionTicks": 0,
-        "Played": true
-        }
-    */
+    if ( mutation.fFavorite.has_value() && requestSetFavorite( mutation.fServerName, mutation.fMediaData, mutation.fNewData, static_cast< int >( index ) ) )
+        retVal++;
+    return retVal;
+}
 
-    // qDebug() << "processing " << mediaData->name();
-    for ( auto &&serverInfo : *fServerModel )
+void CSyncSystem::reportSyncPlanResults( const CSyncPlanExecutor &executor )
+{
+    auto msecs = std::max< qint64 >( executor.elapsedMSecs(), 1 );
+    auto numChanges = executor.plan().size();
+    auto failed = executor.failedMutations();
+    emit sigAddToLog( EMsgType::eInfo, tr( "Sync plan finished: %1 changes, %2 requests in %3 seconds (%4 changes/sec), %5 failed" ).arg( numChanges ).arg( executor.requestsMade() ).arg( msecs / 1000.0, 0, 'f', 1 ).arg( numChanges * 1000.0 / msecs, 0, 'f', 1 ).arg( failed.size() ) );
+    for ( auto &&ii : failed )
     {
-        auto serverName = serverInfo->keyName();
-        bool needsUpdating = mediaData->needsUpdating( serverName );
-        if ( !selectedServer.isEmpty() )
-        {
-            needsUpdating = ( serverName != selectedServer );
-        }
-        if ( !needsUpdating )
-            continue;
-
-        auto newData = selectedServer.isEmpty() ? mediaData->newestMediaData() : mediaData->userMediaData( selectedServer );
-        updateUserDataForMedia( serverName, mediaData, newData );
+        auto &&mutation = executor.plan().mutation( ii );
+        emit sigAddToLog( EMsgType::eWarning, tr( "Failed to update '%1(%2)' on server '%3'" ).arg( mutation.fMediaData->name() ).arg( mutation.fMediaID ).arg( mutation.fServerName ) );
     }
-    return true;
 }
 
-void CSyncSystem::updateUserDataForMedia( const QString &serverName, std::shared_ptr< CMediaData > mediaData, std::shared_ptr< SMediaServerData > newData )
+void CSyncSystem::updateUserDataForMedia( const QString &serverName, const std::shared_ptr< CMediaData > &mediaData, const std::shared_ptr< SMediaServerData > &newData )
 {
     requestUpdateUserDataForMedia( serverName, mediaData, newData );
 
@@ -476,23 +705,124 @@ void CSyncSystem::updateUserDataForMedia( const QString &serverName, std::shared
     requestSetFavorite( serverName, mediaData, newData );
 }
 
-void CSyncSystem::requestUpdateUserDataForMedia( const QString &serverName, std::shared_ptr< CMediaData > mediaData, std::shared_ptr< SMediaServerData > newData )
+void CSyncSystem::syncUserDataChange( const SUserDataChange &change )
 {
-    if ( !mediaData || !mediaData->userMediaData( serverName ) || !newData )
+    if ( fEchoFilter && fEchoFilter->isEcho( change ) )
         return;
 
-    if ( *mediaData->userMediaData( serverName ) == *newData )
-        return;
+    fUserDataChanges.push_back( change );
+    processNextUserDataChange();
+}
+
+void CSyncSystem::processNextUserDataChange()
+{
+    while ( !fUserDataChangeRunning && !fUserDataChanges.empty() )
+    {
+        auto change = fUserDataChanges.front();
+        fUserDataChanges.pop_front();
+
+        auto user = fUsersModel->userDataOnServer( change.fServerName, change.fUserID );
+        if ( !user || !user->canBeSynced() )
+            continue;
+
+        auto mediaData = fMediaModel->getMediaDataForID( change.fServerName, change.fMediaID );
+        if ( !mediaData )
+        {
+            emit sigAddToLog( EMsgType::eInfo, tr( "Media '%1' on server '%2' is not loaded yet, it will be synced by the next full sync" ).arg( change.fMediaID ).arg( change.fServerName ) );
+            continue;
+        }
+
+        if ( !setCurrentUser( ETool::ePlayState, user ) )
+            continue;
+
+        fUserDataChangeRunning = true;
+
+        // the catalog holds the play state of whichever user was loaded last, so the other servers are reloaded for this user before comparing
+        auto operation = std::make_shared< CSyncOperation >(
+            tr( "Reload '%1' for '%2'" ).arg( mediaData->name() ).arg( user->allNames() ), std::initializer_list< ERequestType >{ ERequestType::eReloadMediaData },
+            [ this, change, mediaData ]( const CSyncOperation &operation )
+            {
+                if ( operation.failed() )
+                {
+                    finishUserDataChange( change, mediaData->name(), false, false );
+                    return;
+                }
+
+                // applied after the reload so the event is what the other servers are compared against
+                mediaData->loadUserData( change.fServerName, change.fUserData );
+                auto newData = mediaData->userMediaData( change.fServerName );
+
+                // the updates made here come back as events from the other servers, the echo filter drops those
+                auto changed = std::make_shared< bool >( false );
+                auto update = std::make_shared< CSyncOperation >(
+                    tr( "Sync '%1'" ).arg( mediaData->name() ), std::initializer_list< ERequestType >{ ERequestType::eUpdateUserMediaData, ERequestType::eUpdateFavorite },
+                    [ this, change, mediaData, changed ]( const CSyncOperation &operation ) { finishUserDataChange( change, mediaData->name(), *changed, !operation.failed() ); } );
+                runOperation(
+                    update,
+                    [ this, change, mediaData, newData, update, changed ]()
+                    {
+                        for ( auto &&serverInfo : *fServerModel )
+                        {
+                            if ( serverInfo->isEnabled() && ( serverInfo->keyName() != change.fServerName ) )
+                                updateUserDataForMedia( serverInfo->keyName(), mediaData, newData );
+                        }
+                        *changed = ( update->pendingRequests() > 0 );
+                    } );
+            } );
+        runOperation(
+            operation,
+            [ this, change, mediaData, user ]()
+            {
+                for ( auto &&serverInfo : *fServerModel )
+                {
+                    if ( !serverInfo->isEnabled() || ( serverInfo->keyName() == change.fServerName ) )
+                        continue;
+
+                    auto mediaID = mediaData->getMediaID( serverInfo->keyName() );
+                    auto userID = user->getUserID( serverInfo->keyName() );
+                    if ( !mediaID.isEmpty() && !userID.isEmpty() )
+                        requestReloadMediaItemData( serverInfo, userID, QStringList() << mediaID );
+                }
+            } );
+    }
+}
+
+void CSyncSystem::finishUserDataChange( const SUserDataChange &change, const QString &mediaName, bool changed, bool aOK )
+{
+    fUserDataChangeRunning = false;
+
+    // from the event arriving until the last server confirmed the update
+    auto msecs = QDateTime::currentMSecsSinceEpoch() - change.fReceivedMSecs;
+    if ( aOK && changed )
+    {
+        fUserDataChangeLatency.first++;
+        fUserDataChangeLatency.second += msecs;
+        emit sigAddToLog( EMsgType::eInfo, tr( "Synced the play state of '%1' from server '%2' in %3ms (average %4ms over %5 changes)" ).arg( mediaName ).arg( change.fServerName ).arg( msecs ).arg( fUserDataChangeLatency.second / fUserDataChangeLatency.first ).arg( fUserDataChangeLatency.first ) );
+    }
+    else if ( !aOK )
+        emit sigAddToLog( EMsgType::eWarning, tr( "The play state of '%1' from server '%2' could not be synced, it will be synced by the next full sync" ).arg( mediaName ).arg( change.fServerName ) );
+
+    QTimer::singleShot( 0, this, &CSyncSystem::processNextUserDataChange );
+}
+
+bool CSyncSystem::requestUpdateUserDataForMedia( const QString &serverName, const std::shared_ptr< CMediaData > &mediaData, const std::shared_ptr< SMediaServerData > &newData, int mutationIndex )
+{
+    if ( !mediaData || !newData )
+        return false;
+
+    auto currData = mediaData->serverData( mediaData->serverNum( serverName ) );
+    if ( !currData || ( *currData == *newData ) )
+        return false;
 
     auto &&mediaID = mediaData->getMediaID( serverName );
     auto &&userID = currUser().second->getUserID( serverName );
     if ( userID.isEmpty() || mediaID.isEmpty() )
-        return;
+        return false;
 
     // PlaystateService
     auto &&url = fServerModel->findServerInfo( serverName )->getUrl( QString( "Users/%1/Items/%2/UserData" ).arg( userID ).arg( mediaID ), {} );
     if ( !url.isValid() )
-        return;
+        return false;
 
     auto obj = newData->toJson();
     QByteArray data = QJsonDocument( obj ).toJson();
@@ -503,11 +833,13 @@ void CSyncSystem::requestUpdateUserDataForMedia( const QString &serverName, std:
     // qDebug() << url;
 
     auto request = QNetworkRequest( url );
-    auto reply = makeRequest( request, ENetworkRequestType::ePost, data );
-
-    setServerName( reply, serverName );
-    setExtraData( reply, mediaID );
-    setRequestType( reply, ERequestType::eUpdateUserMediaData );
+    auto context = newRequestContext( serverName, ERequestType::eUpdateUserMediaData );
+    context->fID = mediaID;
+    context->fMutationIndex = mutationIndex;
+    if ( fEchoFilter )
+        fEchoFilter->addWrite( serverName, userID, mediaID, QDateTime::currentMSecsSinceEpoch() );
+    makeRequest( request, context, ENetworkRequestType::ePost, data );
+    return true;
 }
 
 void CSyncSystem::handleUpdateUserDataForMedia( const QString &serverName, const QString &mediaID )
@@ -518,20 +850,23 @@ void CSyncSystem::handleUpdateUserDataForMedia( const QString &serverName, const
         emit sigAddToLog( EMsgType::eInfo, tr( "Updated '%1(%2)' on Server '%3' successfully" ).arg( mediaData->name() ).arg( mediaID ).arg( serverName ) );
 }
 
-void CSyncSystem::requestSetFavorite( const QString &serverName, std::shared_ptr< CMediaData > mediaData, std::shared_ptr< SMediaServerData > newData )
+bool CSyncSystem::requestSetFavorite( const QString &serverName, const std::shared_ptr< CMediaData > &mediaData, const std::shared_ptr< SMediaServerData > &newData, int mutationIndex )
 {
+    // hidden from the current user on the server
+    if ( !mediaData->isValidForServer( serverName ) )
+        return false;
     if ( mediaData->isFavorite( serverName ) == newData->fIsFavorite )
-        return;
+        return false;
 
     auto &&mediaID = mediaData->getMediaID( serverName );
     auto &&userID = currUser().second->getUserID( serverName );
     if ( userID.isEmpty() || mediaID.isEmpty() )
-        return;
+        return false;
 
     // UserLibraryService
     auto &&url = fServerModel->findServerInfo( serverName )->getUrl( QString( "Users/%1/FavoriteItems/%3" ).arg( userID ).arg( mediaID ), {} );
     if ( !url.isValid() )
-        return;
+        return false;
 
     // qDebug() << "userID" << userID;
     // qDebug() << "mediaID" << mediaID;
@@ -539,15 +874,13 @@ void CSyncSystem::requestSetFavorite( const QString &serverName, std::shared_ptr
 
     auto request = QNetworkRequest( url );
 
-    QNetworkReply *reply = nullptr;
-    if ( newData->fIsFavorite )
-        reply = makeRequest( request, ENetworkRequestType::ePost );
-    else
-        reply = makeRequest( request, ENetworkRequestType::eDeleteResource );
-
-    setServerName( reply, serverName );
-    setExtraData( reply, mediaID );
-    setRequestType( reply, ERequestType::eUpdateFavorite );
+    auto context = newRequestContext( serverName, ERequestType::eUpdateFavorite );
+    context->fID = mediaID;
+    context->fMutationIndex = mutationIndex;
+    if ( fEchoFilter )
+        fEchoFilter->addWrite( serverName, userID, mediaID, QDateTime::currentMSecsSinceEpoch() );
+    makeRequest( request, context, newData->fIsFavorite ? ENetworkRequestType::ePost : ENetworkRequestType::eDeleteResource );
+    return true;
 }
 
 void CSyncSystem::handleSetFavorite( const QString &serverName, const QString &mediaID )
@@ -662,11 +995,9 @@ void CSyncSystem::requestUpdateUserData( const QString &serverName, std::shared_
     // qDebug() << url;
 
     auto request = QNetworkRequest( url );
-    auto reply = makeRequest( request, ENetworkRequestType::ePost, data );
-
-    setServerName( reply, serverName );
-    setExtraData( reply, userID );
-    setRequestType( reply, ERequestType::eUpdateUserData );
+    auto context = newRequestContext( serverName, ERequestType::eUpdateUserData );
+    context->fID = userID;
+    makeRequest( request, context, ENetworkRequestType::ePost, data );
 }
 
 void CSyncSystem::handleUpdateUserData( const QString &serverName, const QString &userID )
@@ -674,64 +1005,72 @@ void CSyncSystem::handleUpdateUserData( const QString &serverName, const QString
     requestGetUser( serverName, userID );
 }
 
-void CSyncSystem::setServerName( QNetworkReply *reply, const QString &serverName )
-{
-    if ( !reply )
-        return;
-    fAttributes[ reply ][ kServerName ] = serverName;
-}
-
-QString CSyncSystem::serverName( QNetworkReply *reply )
+QString CSyncSystem::hostName( const QUrl &url )
 {
-    if ( !reply )
-        return false;
-    return fAttributes[ reply ][ kServerName ].toString();
+    auto retVal = url.toString( QUrl::RemovePath | QUrl::RemoveQuery );
+    return retVal;
 }
 
-void CSyncSystem::setRequestType( QNetworkReply *reply, ERequestType requestType )
+SRequestContext *CSyncSystem::newRequestContext( const QString &serverName, ERequestType requestType )
 {
-    if ( !reply )
-        return;
-    fAttributes[ reply ][ kRequestType ] = static_cast< int >( requestType );
-    fRequests[ requestType ][ hostName( reply ) ]++;
+    auto retVal = fRequestContextPool->acquire();
+    retVal->fServerName = serverName;
+    retVal->fServerIndex = fServerModel->getServerPos( serverName );
+    retVal->fRequestType = requestType;
+    if ( fActiveOperation && fActiveOperation->owns( requestType ) )
+        retVal->fOperation = fActiveOperation;
+    return retVal;
 }
 
-QString CSyncSystem::hostName( QNetworkReply *reply )
+SRequestContext *CSyncSystem::takeRequestContext( QNetworkReply *reply )
 {
-    if ( !reply )
-        return {};
+    auto pos = fReplyContexts.find( reply );
+    if ( pos == fReplyContexts.end() )
+        return nullptr;
 
-    auto url = reply->url();
-    auto retVal = url.toString( QUrl::RemovePath | QUrl::RemoveQuery );
+    auto retVal = ( *pos ).second;
+    retVal->fReply = nullptr;
+    fReplyContexts.erase( pos );
     return retVal;
 }
 
-ERequestType CSyncSystem::requestType( QNetworkReply *reply )
+SRequestContext *CSyncSystem::streamContext( quint64 ticket ) const
 {
-    return static_cast< ERequestType >( fAttributes[ reply ][ kRequestType ].toInt() );
+    auto pos = fStreamContexts.find( ticket );
+    if ( pos == fStreamContexts.end() )
+        return nullptr;
+    return ( *pos ).second;
 }
 
-void CSyncSystem::setExtraData( QNetworkReply *reply, QVariant extraData )
+void CSyncSystem::abandonRequest( SRequestContext *context )
 {
-    if ( !reply )
-        return;
-    fAttributes[ reply ][ kExtraData ] = extraData;
+    auto operation = std::move( context->fOperation );
+    auto mutationIndex = context->fMutationIndex;
+    decRequestCount( context );
+    releaseRequestContext( context );
+    if ( operation )
+        operation->requestFinished( false );
+    if ( ( mutationIndex >= 0 ) && fPlanExecutor )
+        fPlanExecutor->requestFinished( mutationIndex, false );
 }
 
-QVariant CSyncSystem::extraData( QNetworkReply *reply )
+void CSyncSystem::releaseRequestContext( SRequestContext *context )
 {
-    if ( !reply )
-        return false;
-    return fAttributes[ reply ][ kExtraData ];
+    if ( context->fStreamTicket )
+    {
+        fStreamContexts.erase( context->fStreamTicket );
+        fResponseParser->cancelStream( context->fStreamTicket );
+    }
+    fRequestContextPool->release( context );
 }
 
-void CSyncSystem::decRequestCount( QNetworkReply *reply, ERequestType requestType )
+void CSyncSystem::decRequestCount( const SRequestContext *context )
 {
-    auto pos = fRequests.find( requestType );
+    auto pos = fRequests.find( context->fRequestType );
     if ( pos == fRequests.end() )
         return;
 
-    auto pos2 = ( *pos ).second.find( hostName( reply ) );
+    auto pos2 = ( *pos ).second.find( context->fHostName );
     if ( pos2 == ( *pos ).second.end() )
         return;
 
@@ -747,14 +1086,36 @@ void CSyncSystem::decRequestCount( QNetworkReply *reply, ERequestType requestTyp
         fRequests.erase( pos );
 }
 
-void CSyncSystem::postHandleRequest( QNetworkReply *reply, const QString &serverName, ERequestType requestType )
+void CSyncSystem::postHandleRequest( SRequestContext *context, bool aOK )
 {
-    decRequestCount( reply, requestType );
+    auto serverName = context->fServerName;
+    auto requestType = context->fRequestType;
+    auto operation = std::move( context->fOperation );
+    auto mutationIndex = context->fMutationIndex;
+
+    decRequestCount( context );
+    releaseRequestContext( context );
+    fRequestScheduler->requestFinished( serverName );
+
+    if ( operation )
+    {
+        // whatever runs on completion is not part of this operation
+        CSyncOperationScope scope( fActiveOperation, {} );
+        operation->requestFinished( aOK );
+    }
+
+    // may start the next changes of the plan, so before checking if anything is still running
+    if ( ( mutationIndex >= 0 ) && fPlanExecutor )
+        fPlanExecutor->requestFinished( mutationIndex, aOK );
+
     if ( !isRunning() )
     {
         fProgressSystem->resetProgress();
         if ( ( requestType == ERequestType::eReloadMediaData ) || ( requestType == ERequestType::eUpdateUserMediaData ) )
+        {
+            finishDeltaSyncRun();
             emit sigProcessingFinished( currUser().second->userName( serverName ) );
+        }
     }
 }
 
@@ -779,7 +1140,23 @@ void CSyncSystem::slotCheckPendingRequests()
             }
         }
     }
-    emit sigAddToLog( EMsgType::eInfo, QString( "There are %1 pending requests across all servers" ).arg( numRequestsTotal ) );
+    for ( auto &&serverName : fRequestScheduler->servers() )
+    {
+        auto inFlight = fRequestScheduler->inFlightCount( serverName );
+        QStringList queued;
+        for ( int ii = 0; ii < static_cast< int >( ERequestPriority::eNumPriorities ); ++ii )
+        {
+            auto priority = static_cast< ERequestPriority >( ii );
+            auto cnt = fRequestScheduler->queuedCount( serverName, priority );
+            if ( cnt )
+                queued << QString( "%1 %2" ).arg( cnt ).arg( toString( priority ) );
+        }
+        if ( !inFlight && queued.isEmpty() )
+            continue;
+        msgs.push_back( QString( "|---> %1 in flight (max %2), queued: %3 on server '%4'" ).arg( inFlight ).arg( fRequestScheduler->maxInFlightPerServer() ).arg( queued.isEmpty() ? QString( "none" ) : queued.join( ", " ) ).arg( serverName ) );
+    }
+
+    emit sigAddToLog( EMsgType::eInfo, QString( "There are %1 pending requests across all servers, %2 waiting to be sent" ).arg( numRequestsTotal ).arg( fRequestScheduler->queuedCount() ) );
     for ( auto &&ii : msgs )
         emit sigAddToLog( EMsgType::eInfo, ii );
 }
@@ -808,19 +1185,17 @@ void CSyncSystem::testServers( const std::vector< std::shared_ptr< const CServer
 
 bool CSyncSystem::isRunning() const
 {
-    return !fAttributes.empty() && !fRequests.empty();
+    return ( ( !fReplyContexts.empty() || !fRequestScheduler->empty() || fResponseParser->isParsing() ) && !fRequests.empty() ) || !fPendingReloads.empty();
 }
 
 void CSyncSystem::slotMergeMedia( ERequestType requestType )
 {
-    if ( !fAttributes.empty() )
-    {
-        QTimer::singleShot( 500, [ this, requestType ]() { slotMergeMedia( requestType ); } );
-        return;
-    }
-
+    logItemFieldsBytes();
     if ( !fMediaModel->mergeMedia( fProgressSystem ) )
+    {
+        fCatalogLoaded = false;   // the model was cleared
         clearCurrUser();
+    }
 
     switch ( requestType )
     {
@@ -867,7 +1242,7 @@ void CSyncSystem::slotSSlErrors( QNetworkReply * /*reply*/, const QList< QSslErr
     // qDebug() << "slotSSlErrors: 0x" << Qt::hex << reply << errors;
 }
 
-QNetworkReply *CSyncSystem::makeRequest( QNetworkRequest &request, ENetworkRequestType requestType, const QByteArray &data, QString contentType )
+void CSyncSystem::makeRequest( QNetworkRequest &request, SRequestContext *context, ENetworkRequestType networkRequestType, const QByteArray &data, QString contentType )
 {
     if ( !fPendingRequestTimer )
     {
@@ -879,46 +1254,127 @@ QNetworkReply *CSyncSystem::makeRequest( QNetworkRequest &request, ENetworkReque
     fPendingRequestTimer->start();
 
     request.setAttribute( QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy );
+    if ( networkRequestType == ENetworkRequestType::ePost )
+    {
+        if ( contentType.isEmpty() )
+            contentType = "application/json";
+        request.setHeader( QNetworkRequest::ContentTypeHeader, contentType );
+    }
 
-    switch ( requestType )
+    context->fHostName = hostName( request.url() );
+    context->fQueuedMSecs = QDateTime::currentMSecsSinceEpoch();
+
+    // counted when queued, so a request waiting on the scheduler is still pending
+    fRequests[ context->fRequestType ][ context->fHostName ]++;
+    if ( context->fOperation )
+        context->fOperation->addRequest();
+
+    fRequestScheduler->setMaxInFlightPerServer( fSettings->maxRequestsPerServer() );
+    fRequestScheduler->enqueue( { request, networkRequestType, data, context } );
+}
+
+// a streamed response holds at most the read buffer in the reply plus the bytes waiting on the parser
+static constexpr qint64 kItemsReadBufferSize = 1024 * 1024;
+static constexpr qint64 kMaxPendingStreamBytes = 2 * 1024 * 1024;
+
+QNetworkReply *CSyncSystem::sendRequest( const SPendingRequest &pendingRequest )
+{
+    QNetworkReply *reply = nullptr;
+    switch ( pendingRequest.fNetworkRequestType )
     {
         case ENetworkRequestType::eDeleteResource:
-            return fManager->deleteResource( request );
+            reply = fManager->deleteResource( pendingRequest.fRequest );
+            break;
         case ENetworkRequestType::ePost:
-            {
-                if ( contentType.isEmpty() )
-                    contentType = "application/json";
-                request.setHeader( QNetworkRequest::ContentTypeHeader, contentType );
-                return fManager->post( request, data );
-            }
+            reply = fManager->post( pendingRequest.fRequest, pendingRequest.fData );
+            break;
         case ENetworkRequestType::eGet:
-            return fManager->get( request );
+            reply = fManager->get( pendingRequest.fRequest );
+            break;
         default:
-            return nullptr;
+            break;
     }
-}
 
-std::shared_ptr< CUserData > CSyncSystem::loadUser( const QString &serverName, const QJsonObject &userData )
-{
-    return fUsersModel->loadUser( serverName, userData );
-}
+    if ( !reply )
+    {
+        abandonRequest( pendingRequest.fContext );
+        return nullptr;
+    }
 
-bool CSyncSystem::isLastRequestOfType( ERequestType type ) const
-{
-    auto pos = fRequests.find( type );
-    if ( pos == fRequests.end() )
-        return true;
-    int cnt = 0;
-    for ( auto &&jj : ( *pos ).second )
-        cnt += jj.second;
-    return cnt <= 1;
+    auto context = pendingRequest.fContext;
+    context->fSentMSecs = QDateTime::currentMSecsSinceEpoch();
+    fReplyContexts[ reply ] = context;
+
+    if ( isStreamedItemsRequest( context->fRequestType ) )
+    {
+        // read the items as they arrive, the bounded read buffer keeps the network side from holding the whole response
+        // and readItemsStream stops reading while the parser is behind, so the download waits instead of queuing up
+        context->fReply = reply;
+        reply->setReadBufferSize( kItemsReadBufferSize );
+        // the parser reports by ticket, a context that was released in the meantime is no longer found
+        context->fStreamTicket = fResponseParser->beginStream(
+            [ this ]( quint64 ticket, const QJsonArray &items )
+            {
+                auto streamedContext = streamContext( ticket );
+                if ( !streamedContext )
+                    return;
+                handleStreamedItems( streamedContext, items );
+                if ( streamedContext->fReply )
+                    readItemsStream( streamedContext->fReply );
+            } );
+        fStreamContexts[ context->fStreamTicket ] = context;
+        connect( reply, &QNetworkReply::readyRead, this, [ this, reply ]() { readItemsStream( reply ); } );
+    }
+    return reply;
 }
 
-// functions to handle the responses from the servers
-bool CSyncSystem::handleError( QNetworkReply *reply, const QString &serverName, QString &errorMsg, bool reportMsg )
+bool CSyncSystem::isStreamedItemsRequest( ERequestType requestType ) const
 {
-    Q_ASSERT( reply );
-    if ( !reply )
+    switch ( requestType )
+    {
+        case ERequestType::eGetMediaList:
+        case ERequestType::eGetUserDataList:
+        case ERequestType::eGetMissingEpisodes:
+        case ERequestType::eGetMissingTVDBid:
+        case ERequestType::eGetAllMovies:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void CSyncSystem::readItemsStream( QNetworkReply *reply )
+{
+    auto pos = fReplyContexts.find( reply );
+    if ( pos == fReplyContexts.end() )
+        return;
+
+    auto context = ( *pos ).second;
+    // error bodies are left for handleError
+    auto status = reply->attribute( QNetworkRequest::HttpStatusCodeAttribute );
+    if ( !context->fStreamTicket || ( status.isValid() && ( status.toInt() >= 300 ) ) )
+        return;
+
+    // the rest stays in the reply's bounded buffer until the worker acknowledges what it was given
+    auto pending = fResponseParser->pendingBytes( context->fStreamTicket );
+    if ( pending >= kMaxPendingStreamBytes )
+        return;
+
+    auto data = reply->read( kMaxPendingStreamBytes - pending );
+    addItemFieldsBytes( context->fRequestType, data.size() );
+    fResponseParser->addStreamData( context->fStreamTicket, data );
+}
+
+std::shared_ptr< CUserData > CSyncSystem::loadUser( const QString &serverName, const QJsonObject &userData )
+{
+    return fUsersModel->loadUser( serverName, userData );
+}
+
+// functions to handle the responses from the servers
+bool CSyncSystem::handleError( QNetworkReply *reply, const QString &serverName, QString &errorMsg, bool reportMsg )
+{
+    Q_ASSERT( reply );
+    if ( !reply )
         return false;
 
     if ( reply && ( reply->error() != QNetworkReply::NoError ) )   // replys with an error do not get cached
@@ -940,53 +1396,43 @@ bool CSyncSystem::handleError( QNetworkReply *reply, const QString &serverName,
 
 void CSyncSystem::slotRequestFinished( QNetworkReply *reply )
 {
-    auto serverName = this->serverName( reply );
-    auto requestType = this->requestType( reply );
-    auto extraData = this->extraData( reply );
+    auto context = takeRequestContext( reply );
+    if ( !context )
+        return;
 
-    auto pos = fAttributes.find( reply );
-    if ( pos != fAttributes.end() )
-    {
-        fAttributes.erase( pos );
-    }
+    auto serverName = context->fServerName;
+    auto requestType = context->fRequestType;
+
+    // requests made while handling the reply belong to the same operation
+    CSyncOperationScope scope( fActiveOperation, context->fOperation );
 
     // emit sigAddToLog( EMsgType::eInfo, QString( "Request Completed: %1" ).arg( reply->url().toString() ) );
     // emit sigAddToLog( EMsgType::eInfo, QString( "Is LHS? %1" ).arg( serverName ? "Yes" : "No" ) );
     // emit sigAddToLog( EMsgType::eInfo, QString( "Request Type: %1" ).arg( toString( requestType ) ) );
-    // emit sigAddToLog( EMsgType::eInfo, QString( "Extra Data: %1" ).arg( extraData.toString() ) );
 
     QString errorMsg;
     if ( !handleError( reply, serverName, errorMsg, requestType != ERequestType::eTestServer ) )
     {
+        fDeltaSyncRun.fFailed = true;   // never move the watermark past data that was not synced
         switch ( requestType )
         {
             case ERequestType::eGetServerInfo:
                 break;
             case ERequestType::eGetUsers:
-                if ( isLastRequestOfType( ERequestType::eGetUsers ) )
-                    emit sigLoadingUsersFinished();
-                break;
             case ERequestType::eGetUser:
             case ERequestType::eGetUserAvatar:
             case ERequestType::eSetUserAvatar:
                 break;
             case ERequestType::eGetMediaList:
-                emit sigUserMediaLoaded();
+                fMediaListPaging.erase( serverName );
                 break;
+            case ERequestType::eGetUserDataList:
             case ERequestType::eGetMissingEpisodes:
-                emit sigMissingEpisodesLoaded();
-                break;
             case ERequestType::eGetMissingTVDBid:
-                emit sigMissingTVDBidLoaded();
-                break;
             case ERequestType::eGetAllMovies:
-                emit sigAllMoviesLoaded();
-                break;
             case ERequestType::eGetAllCollections:
             case ERequestType::eGetAllCollectionsEx:
-                break;
             case ERequestType::eGetCollection:
-                emit sigAllCollectionsLoaded();
                 break;
             case ERequestType::eNone:
             case ERequestType::eReloadMediaData:
@@ -1003,12 +1449,13 @@ void CSyncSystem::slotRequestFinished( QNetworkReply *reply )
                 break;
         }
 
-        postHandleRequest( reply, serverName, requestType );
+        postHandleRequest( context, false );
         return;
     }
 
-    // qDebug() << "Requests Remaining" << fAttributes.size();
+    // qDebug() << "Requests Remaining" << fReplyContexts.size();
     auto data = reply->readAll();
+    addItemFieldsBytes( requestType, data.size() );
     // qDebug() << data;
 
     switch ( requestType )
@@ -1022,79 +1469,38 @@ void CSyncSystem::slotRequestFinished( QNetworkReply *reply )
             handleGetServerHomePageResponse( serverName, data );
             break;
         case ERequestType::eGetServerIcon:
-            handleGetServerIconResponse( serverName, data, extraData.toString() );
+            handleGetServerIconResponse( serverName, data, context->fID );
             break;
         case ERequestType::eGetUsers:
             if ( !fProgressSystem->wasCanceled() )
             {
                 handleGetUsersResponse( serverName, data );
-
-                if ( isLastRequestOfType( ERequestType::eGetUsers ) )
-                    emit sigLoadingUsersFinished();
             }
             break;
         case ERequestType::eGetUser:
             handleGetUserResponse( serverName, data );
             break;
         case ERequestType::eGetUserAvatar:
-            handleGetUserAvatarResponse( serverName, extraData.toString(), data );
+            handleGetUserAvatarResponse( serverName, context->fID, data );
             break;
         case ERequestType::eSetUserAvatar:
-            handleSetUserAvatarResponse( serverName, extraData.toString() );
+            handleSetUserAvatarResponse( serverName, context->fID );
             break;
         case ERequestType::eGetMediaList:
-            if ( !fProgressSystem->wasCanceled() )
-            {
-                handleGetMediaListResponse( serverName, data );
-
-                if ( isLastRequestOfType( ERequestType::eGetMediaList ) )
-                {
-                    fProgressSystem->resetProgress();
-                    slotMergeMedia( requestType );
-                }
-            }
-            break;
+        case ERequestType::eGetUserDataList:
         case ERequestType::eGetMissingEpisodes:
-            {
-                if ( !fProgressSystem->wasCanceled() )
-                {
-                    handleMissingEpisodesResponse( serverName, data );
-
-                    if ( isLastRequestOfType( ERequestType::eGetMissingEpisodes ) )
-                    {
-                        fProgressSystem->resetProgress();
-                        slotMergeMedia( requestType );
-                    }
-                }
-                break;
-            }
         case ERequestType::eGetMissingTVDBid:
-            {
-                if ( !fProgressSystem->wasCanceled() )
-                {
-                    handleMissingTVDBidResponse( serverName, data );
-
-                    if ( isLastRequestOfType( ERequestType::eGetMissingTVDBid ) )
-                    {
-                        fProgressSystem->resetProgress();
-                        slotMergeMedia( requestType );
-                    }
-                }
-                break;
-            }
         case ERequestType::eGetAllMovies:
-            {
-                if ( !fProgressSystem->wasCanceled() )
+            // the items were loaded as they arrived, finished in handleStreamedResponse once the worker has read the rest
+            fResponseParser->addStreamData( context->fStreamTicket, data );
+            fResponseParser->endStream(
+                context->fStreamTicket,
+                [ this ]( quint64 ticket, const QJsonObject &header, bool isItemList, const QString &errorMsg )
                 {
-                    handleAllMoviesResponse( serverName, data );
-                    if ( isLastRequestOfType( ERequestType::eGetAllMovies ) )
-                    {
-                        fProgressSystem->resetProgress();
-                        slotMergeMedia( requestType );
-                    }
-                }
-                break;
-            }
+                    if ( auto streamedContext = streamContext( ticket ) )
+                        handleStreamedResponse( streamedContext, header, isItemList, errorMsg );
+                } );
+            return;
         case ERequestType::eGetAllCollections:
             {
                 if ( !fProgressSystem->wasCanceled() )
@@ -1107,12 +1513,7 @@ void CSyncSystem::slotRequestFinished( QNetworkReply *reply )
             {
                 if ( !fProgressSystem->wasCanceled() )
                 {
-                    auto tmp = extraData.toStringList();
-                    handleAllCollectionsExResponse( serverName, data, tmp.front(), tmp.back() );
-                    if ( isLastRequestOfType( ERequestType::eGetAllCollectionsEx ) )
-                    {
-                        fProgressSystem->resetProgress();
-                    }
+                    handleAllCollectionsExResponse( serverName, data, context->fNameAndID.first, context->fNameAndID.second );
                 }
                 break;
             }
@@ -1120,35 +1521,29 @@ void CSyncSystem::slotRequestFinished( QNetworkReply *reply )
             {
                 if ( !fProgressSystem->wasCanceled() )
                 {
-                    auto extraStrings = extraData.toStringList();
-                    handleGetCollectionResponse( serverName, extraStrings.front(), extraStrings.back(), data );
-                    if ( isLastRequestOfType( ERequestType::eGetCollection ) )
-                    {
-                        emit sigAllCollectionsLoaded();
-                        fProgressSystem->resetProgress();
-                    }
+                    handleGetCollectionResponse( serverName, context->fNameAndID.first, context->fNameAndID.second, data );
                 }
                 break;
             }
         case ERequestType::eReloadMediaData:
             {
-                handleReloadMediaResponse( serverName, data, extraData.toString() );
+                handleReloadMediaResponse( serverName, data, context->fIDs );
                 break;
             }
         case ERequestType::eUpdateUserMediaData:
             {
-                handleUpdateUserDataForMedia( serverName, extraData.toString() );
+                handleUpdateUserDataForMedia( serverName, context->fID );
                 break;
             }
         case ERequestType::eUpdateUserData:
             {
                 // qDebug() << data;
-                handleUpdateUserData( serverName, extraData.toString() );
+                handleUpdateUserData( serverName, context->fID );
                 break;
             }
         case ERequestType::eUpdateFavorite:
             {
-                handleSetFavorite( serverName, extraData.toString() );
+                handleSetFavorite( serverName, context->fID );
                 break;
             }
         case ERequestType::eTestServer:
@@ -1172,7 +1567,109 @@ void CSyncSystem::slotRequestFinished( QNetworkReply *reply )
                 break;
             }
     }
-    postHandleRequest( reply, serverName, requestType );
+    postHandleRequest( context, true );
+}
+
+void CSyncSystem::handleStreamedItems( SRequestContext *context, const QJsonArray &items )
+{
+    if ( fProgressSystem->wasCanceled() )
+        return;
+
+    // only unpaged lists are limited here, paged lists stop requesting pages at the max
+    auto maxItems = context->isMediaListPage() ? -1 : fSettings->maxItems();
+    SMediaListPagingInfo *pagingInfo = nullptr;
+    if ( context->isMediaListPage() )
+    {
+        auto pos = fMediaListPaging.find( context->fServerName );
+        if ( pos != fMediaListPaging.end() )
+            pagingInfo = &( *pos ).second;
+    }
+
+    for ( auto &&ii : items )
+    {
+        context->fItemsReceived++;
+        auto media = ii.toObject();
+        if ( pagingInfo )
+            pagingInfo->fIDsReceived.insert( media[ "Id" ].toString() );
+        if ( CMediaData::isExtra( media ) )
+            continue;
+        if ( ( maxItems > 0 ) && ( context->fItemsLoaded >= maxItems ) )
+            continue;
+
+        if ( context->fRequestType == ERequestType::eGetUserDataList )
+        {
+            if ( !fMediaModel->loadUserData( context->fServerName, media ) )
+                context->fIDs << media[ "Id" ].toString();
+        }
+        else
+        {
+            auto mediaData = fMediaModel->loadMedia( context->fServerName, media );
+            if ( mediaData && fDeltaSyncRun.fIsDelta && !fDeltaSyncRun.fCounterpartsRequested && ( context->fRequestType == ERequestType::eGetMediaList ) )
+            {
+                auto &&providerKeys = fDeltaSyncRun.fChangedProviderKeys[ context->fServerName ];
+                for ( auto &&jj : mediaData->getProviders() )
+                    providerKeys.insert( jj.first.toLower() + "." + jj.second.toLower() );
+            }
+        }
+        context->fItemsLoaded++;
+        fProgressSystem->incProgress();
+    }
+}
+
+void CSyncSystem::handleStreamedResponse( SRequestContext *context, const QJsonObject &header, bool isItemList, const QString &errorMsg )
+{
+    CSyncOperationScope scope( fActiveOperation, context->fOperation );
+    fStreamContexts.erase( context->fStreamTicket );
+    context->fStreamTicket = 0;
+
+    if ( !errorMsg.isEmpty() )
+    {
+        if ( fUserMsgFunc )
+            fUserMsgFunc( EMsgType::eError, tr( "Invalid Response" ), tr( "Invalid Response from Server '%1': %2" ).arg( context->fServerName ).arg( errorMsg ) );
+        if ( context->fRequestType == ERequestType::eGetMediaList )
+            fMediaListPaging.erase( context->fServerName );
+        postHandleRequest( context, false );
+        return;
+    }
+
+    if ( !fProgressSystem->wasCanceled() )
+    {
+        if ( !isItemList )   // a single item
+        {
+            if ( !CMediaData::isExtra( header ) )
+                fMediaModel->loadMedia( context->fServerName, header );
+        }
+
+        switch ( context->fRequestType )
+        {
+            case ERequestType::eGetMediaList:
+                handleGetMediaListResponse( *context, header );
+                break;
+            case ERequestType::eGetUserDataList:
+                handleGetUserDataListResponse( *context );
+                break;
+            case ERequestType::eGetMissingEpisodes:
+                handleMissingEpisodesResponse( *context );
+                break;
+            case ERequestType::eGetMissingTVDBid:
+                handleMissingTVDBidResponse( *context );
+                break;
+            case ERequestType::eGetAllMovies:
+                handleAllMoviesResponse( *context );
+                break;
+            default:
+                break;
+        }
+    }
+    postHandleRequest( context, true );
+}
+
+void CSyncSystem::logStreamedItems( const SRequestContext &context, const QString &logMsg, const QString &partialLogMsg )
+{
+    if ( !logMsg.isEmpty() )
+        emit sigAddToLog( EMsgType::eInfo, logMsg.arg( context.fServerName ).arg( context.fItemsReceived ) );
+    if ( ( fSettings->maxItems() > 0 ) && !partialLogMsg.isEmpty() )
+        emit sigAddToLog( EMsgType::eInfo, partialLogMsg.arg( fSettings->maxItems() ) );
 }
 
 void CSyncSystem::requestTestServer( std::shared_ptr< const CServerInfo > serverInfo )
@@ -1191,9 +1688,7 @@ void CSyncSystem::requestTestServer( std::shared_ptr< const CServerInfo > server
 
     auto request = QNetworkRequest( url );
 
-    auto reply = makeRequest( request );
-    setServerName( reply, serverInfo->keyName() );
-    setRequestType( reply, ERequestType::eTestServer );
+    makeRequest( request, newRequestContext( serverInfo->keyName(), ERequestType::eTestServer ) );
 }
 
 void CSyncSystem::handleTestServer( const QString &serverName )
@@ -1223,9 +1718,7 @@ void CSyncSystem::requestGetServerInfo( const QString &serverName )
 
     auto request = QNetworkRequest( url );
 
-    auto reply = makeRequest( request );
-    setServerName( reply, serverName );
-    setRequestType( reply, ERequestType::eGetServerInfo );
+    makeRequest( request, newRequestContext( serverName, ERequestType::eGetServerInfo ) );
 }
 
 void CSyncSystem::handleGetServerInfoResponse( const QString &serverName, const QByteArray &data )
@@ -1258,9 +1751,7 @@ void CSyncSystem::requestGetServerHomePage( const QString &serverName )
 
     auto request = QNetworkRequest( url );
 
-    auto reply = makeRequest( request );
-    setServerName( reply, serverName );
-    setRequestType( reply, ERequestType::eGetServerHomePage );
+    makeRequest( request, newRequestContext( serverName, ERequestType::eGetServerHomePage ) );
 }
 
 void CSyncSystem::handleGetServerHomePageResponse( const QString &serverName, const QByteArray &data )
@@ -1295,10 +1786,9 @@ void CSyncSystem::requestGetServerIcon( const QString &serverName, const QString
 
     auto request = QNetworkRequest( url );
 
-    auto reply = makeRequest( request );
-    setServerName( reply, serverName );
-    setExtraData( reply, type );
-    setRequestType( reply, ERequestType::eGetServerIcon );
+    auto context = newRequestContext( serverName, ERequestType::eGetServerIcon );
+    context->fID = type;
+    makeRequest( request, context );
 }
 
 void CSyncSystem::handleGetServerIconResponse( const QString &serverName, const QByteArray &data, const QString &type )
@@ -1319,9 +1809,7 @@ void CSyncSystem::requestGetUsers( const QString &serverName )
 
     auto request = QNetworkRequest( url );
 
-    auto reply = makeRequest( request );
-    setServerName( reply, serverName );
-    setRequestType( reply, ERequestType::eGetUsers );
+    makeRequest( request, newRequestContext( serverName, ERequestType::eGetUsers ) );
 }
 
 void CSyncSystem::handleGetUsersResponse( const QString &serverName, const QByteArray &data )
@@ -1369,9 +1857,7 @@ void CSyncSystem::requestGetUser( const QString &serverName, const QString &user
 
     auto request = QNetworkRequest( url );
 
-    auto reply = makeRequest( request );
-    setServerName( reply, serverName );
-    setRequestType( reply, ERequestType::eGetUser );
+    makeRequest( request, newRequestContext( serverName, ERequestType::eGetUser ) );
 }
 
 void CSyncSystem::handleGetUserResponse( const QString &serverName, const QByteArray &data )
@@ -1407,10 +1893,9 @@ void CSyncSystem::requestGetUserAvatar( const QString &serverName, const QString
         return;
     auto request = QNetworkRequest( url );
 
-    auto reply = makeRequest( request );
-    setServerName( reply, serverName );
-    setRequestType( reply, ERequestType::eGetUserAvatar );
-    setExtraData( reply, userID );
+    auto context = newRequestContext( serverName, ERequestType::eGetUserAvatar );
+    context->fID = userID;
+    makeRequest( request, context );
 }
 
 void CSyncSystem::handleGetUserAvatarResponse( const QString &serverName, const QString &userID, const QByteArray &data )
@@ -1438,10 +1923,9 @@ void CSyncSystem::requestSetUserAvatar( const QString &serverName, const QString
     buffer.open( QIODevice::WriteOnly );
     image.save( &buffer, "PNG" );   // writes image into ba in PNG format
 
-    auto reply = makeRequest( request, ENetworkRequestType::ePost, data.toBase64(), "image/png" );
-    setServerName( reply, serverName );
-    setRequestType( reply, ERequestType::eSetUserAvatar );
-    setExtraData( reply, userID );
+    auto context = newRequestContext( serverName, ERequestType::eSetUserAvatar );
+    context->fID = userID;
+    makeRequest( request, context, ENetworkRequestType::ePost, data.toBase64(), "image/png" );
 }
 
 void CSyncSystem::handleSetUserAvatarResponse( const QString &serverName, const QString &userID )
@@ -1542,9 +2026,7 @@ void CSyncSystem::requestDeleteConnectedID( const QString &serverName )
 
     emit sigAddToLog( EMsgType::eInfo, QString( "Deleting ConnectID for User '%1' from server '%2'" ).arg( fCurrUserConnectID.fUserData->userName( serverName ) ).arg( serverName ) );
 
-    auto reply = makeRequest( request, ENetworkRequestType::eDeleteResource );
-    setServerName( reply, serverName );
-    setRequestType( reply, ERequestType::eDeleteConnectedID );
+    makeRequest( request, newRequestContext( serverName, ERequestType::eDeleteConnectedID ), ENetworkRequestType::eDeleteResource );
 }
 
 void CSyncSystem::handleDeleteConnectedID( const QString &serverName )
@@ -1577,9 +2059,7 @@ void CSyncSystem::requestSetConnectedID( const QString &serverName )
 
     emit sigAddToLog( EMsgType::eInfo, QString( "Setting ConnectID for User '%1' from server '%2' to '%3'" ).arg( fCurrUserConnectID.fUserData->userName( serverName ) ).arg( serverName ).arg( fCurrUserConnectID.fConnectID.second ) );
 
-    auto reply = makeRequest( request, ENetworkRequestType::ePost );
-    setServerName( reply, serverName );
-    setRequestType( reply, ERequestType::eSetConnectedID );
+    makeRequest( request, newRequestContext( serverName, ERequestType::eSetConnectedID ), ENetworkRequestType::ePost );
 }
 
 void CSyncSystem::handleSetConnectedID( const QString &serverName )
@@ -1591,31 +2071,116 @@ void CSyncSystem::handleSetConnectedID( const QString &serverName )
     return fUsersModel->updateUserConnectID( serverName, fCurrUserConnectID.fUserData->getUserID( serverName ), fCurrUserConnectID.fUserData->connectedIDType(), fCurrUserConnectID.fUserData->connectedID() );
 }
 
-QString CSyncSystem::getItemFields() const
-{
-    static QStringList items{ //
-                              "Path",   //
-                              "ProviderIds",   //
-                              "ExternalUrls",   //
-                              "Missing",   //
-                              "ProductionYear",   //
-                              "PremiereDate",   //
-                              "DateCreated",   //
-                              "PremierDate",   //
-                              "EndDate",   //
-                              "StartDate",   //
-                              "OriginalTitle",   //
-                              "MediaSources" };
-    static auto retVal = items.join( "," );
-    return retVal;
+ETool CSyncSystem::itemFieldsTool( ERequestType requestType ) const
+{
+    switch ( requestType )
+    {
+        case ERequestType::eGetMissingEpisodes:
+            return ETool::eMissingEpisodes;
+        case ERequestType::eGetMissingTVDBid:
+            return ETool::eMissingTMDBId;
+        case ERequestType::eGetAllMovies:
+            return ETool::eMissingMovies;
+        case ERequestType::eGetMediaList:
+        case ERequestType::eReloadMediaData:
+            return currUser().first;
+        default:
+            return ETool::eNone;
+    }
 }
 
-void CSyncSystem::requestGetMediaList( const QString &serverName )
+// each tool only asks for the fields it displays or matches on.  Every tool shows the media model and its
+// resolution column, so MediaSources is kept, what is dropped are the dates and flags only the movie tools match on
+QString CSyncSystem::getItemFields( ERequestType requestType ) const
+{
+    static auto sPlayStateFields = QStringList( { //
+                                                  "Path",   //
+                                                  "ProviderIds",   //
+                                                  "ExternalUrls",   //
+                                                  "PremiereDate",   //
+                                                  "OriginalTitle",   //
+                                                  "MediaSources" } )
+                                       .join( "," );
+    static auto sMissingFields = QStringList( { //
+                                                "Path",   //
+                                                "ProviderIds",   //
+                                                "ExternalUrls",   //
+                                                "Missing",   //
+                                                "ProductionYear",   //
+                                                "PremiereDate",   //
+                                                "OriginalTitle",   //
+                                                "MediaSources" } )
+                                     .join( "," );
+    static auto sAllFields = QStringList( { //
+                                            "Path",   //
+                                            "ProviderIds",   //
+                                            "ExternalUrls",   //
+                                            "Missing",   //
+                                            "ProductionYear",   //
+                                            "PremiereDate",   //
+                                            "DateCreated",   //
+                                            "PremierDate",   //
+                                            "EndDate",   //
+                                            "StartDate",   //
+                                            "OriginalTitle",   //
+                                            "MediaSources" } )
+                                 .join( "," );
+
+    switch ( itemFieldsTool( requestType ) )
+    {
+        case ETool::ePlayState:
+            return sPlayStateFields;
+        case ETool::eMissingEpisodes:
+        case ETool::eMissingTMDBId:
+            return sMissingFields;
+        default:
+            return sAllFields;
+    }
+}
+
+void CSyncSystem::addItemFieldsBytes( ERequestType requestType, qint64 numBytes )
+{
+    auto tool = itemFieldsTool( requestType );
+    if ( tool == ETool::eNone )
+        return;
+
+    auto &&bytes = fItemFieldsBytes[ tool ];
+    bytes.first += numBytes;
+    bytes.second++;
+}
+
+void CSyncSystem::logItemFieldsBytes()
+{
+    if ( fItemFieldsBytes.empty() )
+        return;
+
+    QStringList profiles;
+    for ( auto &&ii : fItemFieldsBytes )
+    {
+        auto perResponse = ii.second.second ? ( ii.second.first / ii.second.second ) : 0;
+        profiles << QString( "%1: %2 in %3 responses (%4 per response)" ).arg( toString( ii.first ) ).arg( QLocale().formattedDataSize( ii.second.first ) ).arg( ii.second.second ).arg( QLocale().formattedDataSize( perResponse ) );
+    }
+    emit sigAddToLog( EMsgType::eInfo, QString( "Items bytes transferred per field profile - %1" ).arg( profiles.join( ", " ) ) );
+}
+
+void CSyncSystem::requestGetMediaList( const QString &serverName, bool allowPaging )
 {
     if ( !currUser().second )
         return;
 
-    std::list< std::pair< QString, QString > > queryItems = { std::make_pair( "IncludeItemTypes", fSettings->getSyncItemTypes() ), std::make_pair( "SortBy", "Type,ProductionYear,PremiereDate,SortName" ), std::make_pair( "SortOrder", "Ascending" ), std::make_pair( "Recursive", "True" ), std::make_pair( "IsMissing", "False" ), std::make_pair( "Fields", getItemFields() ) };
+    auto pageSize = fSettings->mediaPageSize();
+    if ( allowPaging && ( pageSize > 0 ) )
+    {
+        fMediaListPaging[ serverName ] = SMediaListPagingInfo();
+        fMediaListPaging[ serverName ].fPageSize = pageSize;
+        emit sigAddToLog( EMsgType::eInfo, QString( "Requesting media for '%1' from server '%2' in pages of %3 items" ).arg( currUser().second->userName( serverName ) ).arg( serverName ).arg( pageSize ) );
+        requestNextMediaListPages( serverName );
+        return;
+    }
+
+    std::list< std::pair< QString, QString > > queryItems = { std::make_pair( "IncludeItemTypes", fSettings->getSyncItemTypes() ), std::make_pair( "SortBy", "Type,ProductionYear,PremiereDate,SortName" ), std::make_pair( "SortOrder", "Ascending" ), std::make_pair( "Recursive", "True" ), std::make_pair( "IsMissing", "False" ), std::make_pair( "Fields", getItemFields( ERequestType::eGetMediaList ) ) };
+    addNoImagesQueryItems( queryItems );
+    addDeltaSyncQueryItems( serverName, queryItems );
 
     // ItemsService
     auto &&url = fServerModel->findServerInfo( serverName )->getUrl( QString( "Users/%1/Items" ).arg( currUser().second->getUserID( serverName ) ), queryItems );
@@ -1627,9 +2192,81 @@ void CSyncSystem::requestGetMediaList( const QString &serverName )
 
     emit sigAddToLog( EMsgType::eInfo, QString( "Requesting media for '%1' from server '%2'" ).arg( currUser().second->userName( serverName ) ).arg( serverName ) );
 
-    auto reply = makeRequest( request );
-    setServerName( reply, serverName );
-    setRequestType( reply, ERequestType::eGetMediaList );
+    makeRequest( request, newRequestContext( serverName, ERequestType::eGetMediaList ) );
+}
+
+void CSyncSystem::requestGetMediaListPage( const QString &serverName, int startIndex, int limit )
+{
+    // the pages are separate queries, the Id makes the order total so an item can not move between pages
+    std::list< std::pair< QString, QString > > queryItems = {
+        std::make_pair( "IncludeItemTypes", fSettings->getSyncItemTypes() ),   //
+        std::make_pair( "SortBy", "Type,ProductionYear,PremiereDate,SortName,Id" ),   //
+        std::make_pair( "SortOrder", "Ascending" ),   //
+        std::make_pair( "Recursive", "True" ),   //
+        std::make_pair( "IsMissing", "False" ),   //
+        std::make_pair( "StartIndex", QString::number( startIndex ) ),   //
+        std::make_pair( "Limit", QString::number( limit ) ),   //
+        std::make_pair( "EnableTotalRecordCount", ( startIndex == 0 ) ? "True" : "False" ),   //
+        std::make_pair( "Fields", getItemFields( ERequestType::eGetMediaList ) ) };
+    addNoImagesQueryItems( queryItems );
+    addDeltaSyncQueryItems( serverName, queryItems );
+
+    // ItemsService
+    auto &&url = fServerModel->findServerInfo( serverName )->getUrl( QString( "Users/%1/Items" ).arg( currUser().second->getUserID( serverName ) ), queryItems );
+    if ( !url.isValid() )
+        return;
+
+    // qDebug().noquote().nospace() << url;
+    auto request = QNetworkRequest( url );
+
+    auto context = newRequestContext( serverName, ERequestType::eGetMediaList );
+    context->fStartIndex = startIndex;
+    context->fLimit = limit;
+    makeRequest( request, context );
+}
+
+void CSyncSystem::requestNextMediaListPages( const QString &serverName )
+{
+    auto pos = fMediaListPaging.find( serverName );
+    if ( pos == fMediaListPaging.end() )
+        return;
+
+    auto &&pagingInfo = ( *pos ).second;
+    auto maxInFlight = std::max( 1, fSettings->maxPagesInFlight() );
+    while ( pagingInfo.fPagesInFlight < maxInFlight )
+    {
+        // until the first page comes back, the total number of items is not known
+        if ( pagingInfo.fTotalRecordCount < 0 )
+        {
+            if ( pagingInfo.fPagesInFlight > 0 )
+                break;
+        }
+        else if ( pagingInfo.fNextStartIndex >= pagingInfo.fTotalRecordCount )
+            break;
+
+        auto limit = pagingInfo.fPageSize;
+        if ( fSettings->maxItems() > 0 )
+        {
+            if ( pagingInfo.fNextStartIndex >= fSettings->maxItems() )
+                break;
+            limit = std::min( limit, fSettings->maxItems() - pagingInfo.fNextStartIndex );
+        }
+
+        requestGetMediaListPage( serverName, pagingInfo.fNextStartIndex, limit );
+        pagingInfo.fNextStartIndex += limit;
+        pagingInfo.fPagesInFlight++;
+    }
+
+    if ( pagingInfo.fPagesInFlight > 0 )
+        return;
+
+    // items added or removed while the list was paged shift the pages, some items are then missed or loaded twice
+    auto listChanged = pagingInfo.fTotalFromServer && ( fSettings->maxItems() <= 0 ) && ( static_cast< int >( pagingInfo.fIDsReceived.size() ) != pagingInfo.fTotalRecordCount );
+    if ( listChanged )
+        emit sigAddToLog( EMsgType::eWarning, tr( "Server '%1' reported %2 media items but %3 different items were paged in, requesting the media list in one request" ).arg( serverName ).arg( pagingInfo.fTotalRecordCount ).arg( pagingInfo.fIDsReceived.size() ) );
+    fMediaListPaging.erase( pos );
+    if ( listChanged )
+        requestGetMediaList( serverName, false );
 }
 
 std::list< std::shared_ptr< CMediaData > > CSyncSystem::handleGetMediaListResponse( const QString &serverName, const QByteArray &data, const QString &progressTitle, const QString &logMsg, const QString &partialLogMsg )
@@ -1643,6 +2280,11 @@ std::list< std::shared_ptr< CMediaData > > CSyncSystem::handleGetMediaListRespon
         return {};
     }
 
+    return handleGetMediaListResponse( serverName, doc, progressTitle, logMsg, partialLogMsg );
+}
+
+std::list< std::shared_ptr< CMediaData > > CSyncSystem::handleGetMediaListResponse( const QString &serverName, const QJsonDocument &doc, const QString &progressTitle, const QString &logMsg, const QString &partialLogMsg )
+{
     // qDebug() << doc.toJson();
     if ( !doc[ "Items" ].isArray() )
     {
@@ -1652,7 +2294,11 @@ std::list< std::shared_ptr< CMediaData > > CSyncSystem::handleGetMediaListRespon
         return {};
     }
 
-    auto mediaList = doc[ "Items" ].toArray();
+    return loadMediaList( serverName, doc[ "Items" ].toArray(), fSettings->maxItems(), progressTitle, logMsg, partialLogMsg );
+}
+
+std::list< std::shared_ptr< CMediaData > > CSyncSystem::loadMediaList( const QString &serverName, const QJsonArray &mediaList, int maxItems, const QString &progressTitle, const QString &logMsg, const QString &partialLogMsg )
+{
     auto showProgress = mediaList.count() > 10;
     if ( showProgress )
     {
@@ -1662,9 +2308,10 @@ std::list< std::shared_ptr< CMediaData > > CSyncSystem::handleGetMediaListRespon
         fProgressSystem->setTitle( progressTitle );
         fProgressSystem->setMaximum( mediaList.count() );
     }
-    emit sigAddToLog( EMsgType::eInfo, logMsg.arg( serverName ).arg( mediaList.count() ) );
-    if ( fSettings->maxItems() > 0 )
-        emit sigAddToLog( EMsgType::eInfo, partialLogMsg.arg( fSettings->maxItems() ) );
+    if ( !logMsg.isEmpty() )
+        emit sigAddToLog( EMsgType::eInfo, logMsg.arg( serverName ).arg( mediaList.count() ) );
+    if ( ( maxItems > 0 ) && !partialLogMsg.isEmpty() )
+        emit sigAddToLog( EMsgType::eInfo, partialLogMsg.arg( maxItems ) );
 
     int curr = 0;
     std::list< std::shared_ptr< CMediaData > > retVal;
@@ -1674,9 +2321,9 @@ std::list< std::shared_ptr< CMediaData > > CSyncSystem::handleGetMediaListRespon
         auto media = ii.toObject();
         if ( CMediaData::isExtra( media ) )
             continue;
-        if ( fSettings->maxItems() > 0 )
+        if ( maxItems > 0 )
         {
-            if ( retVal.size() >= fSettings->maxItems() )
+            if ( retVal.size() >= maxItems )
                 break;
         }
         curr++;
@@ -1701,14 +2348,420 @@ std::list< std::shared_ptr< CMediaData > > CSyncSystem::handleGetMediaListRespon
     return retVal;
 }
 
-void CSyncSystem::handleGetMediaListResponse( const QString &serverName, const QByteArray &data )
+void CSyncSystem::handleGetMediaListResponse( const SRequestContext &context, const QJsonObject &header )
+{
+    if ( context.isMediaListPage() )
+    {
+        handleGetMediaListPageResponse( context, header );
+        return;
+    }
+
+    logStreamedItems( context, tr( "%1 has %2 media items on server '%3'" ), tr( "Loading %2 media items" ) );
+}
+
+void CSyncSystem::handleGetMediaListPageResponse( const SRequestContext &context, const QJsonObject &header )
+{
+    static constexpr int kMinPageSize = 100;
+    static constexpr int kMaxPageSize = 10000;
+    static constexpr qint64 kTargetPageMSecs = 2000;
+
+    auto &&serverName = context.fServerName;
+    auto startIndex = context.fStartIndex;
+    auto limit = context.fLimit;
+    auto numItems = context.fItemsReceived;
+
+    auto pos = fMediaListPaging.find( serverName );
+    if ( pos == fMediaListPaging.end() )
+        return;
+
+    auto &&pagingInfo = ( *pos ).second;
+    pagingInfo.fPagesInFlight--;
+
+    // only the first page asks for the total count
+    if ( ( startIndex == 0 ) && header.contains( "TotalRecordCount" ) )
+    {
+        pagingInfo.fTotalRecordCount = header[ "TotalRecordCount" ].toInt();
+        pagingInfo.fTotalFromServer = true;
+    }
+    else if ( pagingInfo.fTotalRecordCount < 0 )
+        pagingInfo.fTotalRecordCount = ( numItems < limit ) ? ( startIndex + numItems ) : std::numeric_limits< int >::max();
+
+    if ( numItems < limit )   // a short page means there is nothing past this one
+        pagingInfo.fTotalRecordCount = std::min( pagingInfo.fTotalRecordCount, startIndex + numItems );
+
+    pagingInfo.fItemsLoaded += context.fItemsLoaded;
+
+    auto total = pagingInfo.fTotalRecordCount;
+    if ( fSettings->maxItems() > 0 )
+        total = std::min( total, fSettings->maxItems() );
+    emit sigAddToLog( EMsgType::eInfo, tr( "Loaded %1 of %2 media items from server '%3'" ).arg( std::min( startIndex + numItems, total ) ).arg( total ).arg( serverName ) );
+
+    // keep each page near the target time, large pages for fast servers, smaller for slow ones
+    auto elapsed = QDateTime::currentMSecsSinceEpoch() - context.fSentMSecs;
+    if ( ( elapsed < ( kTargetPageMSecs / 2 ) ) && ( numItems == limit ) )
+        pagingInfo.fPageSize = std::min( pagingInfo.fPageSize * 2, kMaxPageSize );
+    else if ( elapsed > ( kTargetPageMSecs * 2 ) )
+        pagingInfo.fPageSize = std::max( pagingInfo.fPageSize / 2, kMinPageSize );
+
+    requestNextMediaListPages( serverName );
+}
+
+void CSyncSystem::requestGetUserDataList( const QString &serverName )
+{
+    if ( !currUser().second )
+        return;
+
+    auto &&listInfo = fUserDataLists[ serverName ];
+    listInfo = SUserDataListInfo();
+    // a delta has the items that were changed back to the default play state, the sparse filters would drop them
+    if ( !fSettings->sparseUserData() || fDeltaSyncRun.fIsDelta )
+    {
+        listInfo.fPending = 1;
+        requestGetUserDataList( serverName, {} );
+        return;
+    }
+
+    // most items were never played, only the ones with a play state are asked for and the rest are left at the default.
+    // Emby ands its filters together, so each one is a request of its own
+    static const std::pair< QString, QString > sFilters[] = { { "IsPlayed", "True" }, { "IsFavorite", "True" }, { "Filters", "IsResumable" } };
+    listInfo.fPending = static_cast< int >( std::size( sFilters ) );
+    for ( auto &&filter : sFilters )
+        requestGetUserDataList( serverName, filter );
+}
+
+void CSyncSystem::requestGetUserDataList( const QString &serverName, const std::pair< QString, QString > &filter )
+{
+    // no Fields, the default item has the Id and UserData and none of the metadata the catalog already holds
+    std::list< std::pair< QString, QString > > queryItems = {
+        std::make_pair( "IncludeItemTypes", fSettings->getSyncItemTypes() ),   //
+        std::make_pair( "Recursive", "True" ),   //
+        std::make_pair( "IsMissing", "False" ),   //
+        std::make_pair( "EnableUserData", "True" ) };
+    addNoImagesQueryItems( queryItems );
+    if ( !filter.first.isEmpty() )
+        queryItems.push_back( filter );
+    addDeltaSyncQueryItems( serverName, queryItems );
+
+    // ItemsService
+    auto &&url = fServerModel->findServerInfo( serverName )->getUrl( QString( "Users/%1/Items" ).arg( currUser().second->getUserID( serverName ) ), queryItems );
+    if ( !url.isValid() )
+        return;
+
+    // qDebug().noquote().nospace() << url;
+    auto request = QNetworkRequest( url );
+
+    makeRequest( request, newRequestContext( serverName, ERequestType::eGetUserDataList ) );
+}
+
+void CSyncSystem::handleGetUserDataListResponse( const SRequestContext &context )
+{
+    auto pos = fUserDataLists.find( context.fServerName );
+    if ( pos == fUserDataLists.end() )
+        return;
+
+    auto &&listInfo = ( *pos ).second;
+    listInfo.fItemsLoaded += context.fItemsLoaded - context.fIDs.count();
+    listInfo.fMissingIDs.insert( context.fIDs.begin(), context.fIDs.end() );
+    if ( --listInfo.fPending > 0 )
+        return;
+
+    if ( !fSettings->sparseUserData() || fDeltaSyncRun.fIsDelta || listInfo.fGapsRequested )
+    {
+        finishUserDataList( context.fServerName );
+        return;
+    }
+
+    // the gaps are only known once every server has returned its lists
+    for ( auto &&ii : fUserDataLists )
+    {
+        if ( ii.second.fPending > 0 )
+            return;
+    }
+    requestSparseUserDataGaps();
+}
+
+void CSyncSystem::requestSparseUserDataGaps()
+{
+    static constexpr int kMaxIDsPerRequest = 100;
+
+    // an item one server returned a play state for is either default on the others, or was changed back to the default
+    // there more recently, only the server's own user data for it can tell, so those items are asked for by ID
+    auto gaps = fMediaModel->sparseUserDataGaps();
+    QStringList finished;
+    for ( auto &&ii : fUserDataLists )
+    {
+        auto &&serverName = ii.first;
+        auto &&listInfo = ii.second;
+        listInfo.fGapsRequested = true;
+
+        auto pos = gaps.find( serverName );
+        if ( pos == gaps.end() )
+        {
+            finished << serverName;
+            continue;
+        }
+
+        auto &&ids = ( *pos ).second;
+        emit sigAddToLog( EMsgType::eInfo, tr( "Requesting the play state of %1 media items from server '%2' that another server returned a play state for" ).arg( ids.count() ).arg( serverName ) );
+        for ( int jj = 0; jj < ids.count(); jj += kMaxIDsPerRequest )
+        {
+            listInfo.fPending++;
+            requestGetUserDataList( serverName, std::make_pair( QString( "Ids" ), ids.mid( jj, kMaxIDsPerRequest ).join( "," ) ) );
+        }
+    }
+
+    for ( auto &&ii : finished )
+        finishUserDataList( ii );
+}
+
+void CSyncSystem::finishUserDataList( const QString &serverName )
+{
+    static constexpr int kMaxIDsPerRequest = 100;
+
+    auto pos = fUserDataLists.find( serverName );
+    if ( pos == fUserDataLists.end() )
+        return;
+
+    auto missingIDs = std::move( ( *pos ).second.fMissingIDs );
+    auto itemsLoaded = ( *pos ).second.fItemsLoaded;
+    fUserDataLists.erase( pos );
+
+    // a full list leaves out what the user can not see, a sparse one only has what is not the default play state
+    // and a delta only what changed, the catalog already holds this user's play state for the rest
+    auto sparse = fSettings->sparseUserData();
+    int numUnseen = 0;
+    if ( fDeltaSyncRun.fIsDelta )
+        fMediaModel->cancelUserDataLoad( serverName );
+    else
+        numUnseen = fMediaModel->endUserDataLoad( serverName, !sparse );
+    emit sigAddToLog( EMsgType::eInfo, tr( "Loaded the play state of %1 media items from server '%2'" ).arg( itemsLoaded ).arg( serverName ) );
+    if ( numUnseen > 0 )
+    {
+        auto userName = currUser().second->userName( serverName );
+        if ( sparse )
+            emit sigAddToLog( EMsgType::eInfo, tr( "%1 media items on server '%2' were not returned for '%3' and have the default play state or are not visible" ).arg( numUnseen ).arg( serverName ).arg( userName ) );
+        else
+            emit sigAddToLog( EMsgType::eInfo, tr( "%1 media items on server '%2' are not visible to '%3' and will not be synced there" ).arg( numUnseen ).arg( serverName ).arg( userName ) );
+    }
+
+    if ( missingIDs.empty() )
+        return;
+
+    emit sigAddToLog( EMsgType::eInfo, tr( "Requesting %1 media items missing from the catalog from server '%2'" ).arg( missingIDs.size() ).arg( serverName ) );
+    QStringList ids;
+    for ( auto &&ii : missingIDs )
+    {
+        ids << ii;
+        if ( ids.count() == kMaxIDsPerRequest )
+        {
+            requestGetMediaListForIDs( serverName, ids );
+            ids.clear();
+        }
+    }
+    if ( !ids.isEmpty() )
+        requestGetMediaListForIDs( serverName, ids );
+}
+
+void CSyncSystem::requestGetMediaListForIDs( const QString &serverName, const QStringList &mediaIDs )
+{
+    std::list< std::pair< QString, QString > > queryItems = {
+        std::make_pair( "Ids", mediaIDs.join( "," ) ),   //
+        std::make_pair( "Fields", getItemFields( ERequestType::eGetMediaList ) ) };
+    addNoImagesQueryItems( queryItems );
+
+    // ItemsService
+    auto &&url = fServerModel->findServerInfo( serverName )->getUrl( QString( "Users/%1/Items" ).arg( currUser().second->getUserID( serverName ) ), queryItems );
+    if ( !url.isValid() )
+        return;
+
+    // qDebug().noquote().nospace() << url;
+    auto request = QNetworkRequest( url );
+
+    makeRequest( request, newRequestContext( serverName, ERequestType::eGetMediaList ) );
+}
+
+void CSyncSystem::startDeltaSyncRun( ETool tool )
+{
+    fDeltaSyncRun = SDeltaSyncRun();
+    if ( !fDeltaSyncAllowed || ( tool != ETool::ePlayState ) || !fSettings->deltaSync() || !currUser().second )
+        return;
+
+    if ( !fDeltaSyncState || ( fDeltaSyncState->fileName() != CDeltaSyncState::stateFileName( fSettings->fileName() ) ) )
+        fDeltaSyncState = std::make_shared< CDeltaSyncState >( fSettings->fileName() );
+
+    // a shared state is loaded by the first run that needs it, the others use its watermarks as they are now
+    if ( !fDeltaSyncState->isLoaded() )
+    {
+        QString errorMsg;
+        if ( !fDeltaSyncState->load( errorMsg ) )
+        {
+            emit sigAddToLog( EMsgType::eWarning, tr( "Delta sync state could not be loaded, running a full refresh: %1" ).arg( errorMsg ) );
+            return;
+        }
+    }
+
+    // a shared catalog has to be complete, only the play state of the user the catalog already holds is loaded as a delta.
+    // The other loads are full but still set the watermark, so the next cycle of a daemon can be a delta
+    fDeltaSyncRun.fEnabled = true;
+    fDeltaSyncRun.fIsDelta = !fSharedCatalog || ( fCatalogLoaded && ( fCatalogUser == currUser().second ) );
+    fDeltaSyncRun.fRunStart = QDateTime::currentDateTimeUtc();
+    for ( auto &&serverInfo : *fServerModel )
+    {
+        if ( !serverInfo->isEnabled() )
+            continue;
+
+        auto watermark = fDeltaSyncState->watermark( serverInfo->keyName(), currUser().second->getUserID( serverInfo->keyName() ) );
+        if ( !watermark.fWatermark.isValid() || ( ( watermark.fRunsSinceFullRefresh + 1 ) >= fSettings->deltaSyncFullRefreshRuns() ) )
+            fDeltaSyncRun.fIsDelta = false;
+
+        fDeltaSyncRun.fSince[ serverInfo->keyName() ] = watermark.fWatermark;
+        fDeltaSyncRun.fRunsSinceFullRefresh = std::max( fDeltaSyncRun.fRunsSinceFullRefresh, watermark.fRunsSinceFullRefresh );
+    }
+
+    if ( fDeltaSyncRun.fIsDelta )
+        emit sigAddToLog( EMsgType::eInfo, tr( "Delta sync for '%1', loading media changed since the last sync" ).arg( currUser().second->allNames() ) );
+    else
+        emit sigAddToLog( EMsgType::eInfo, tr( "Full refresh for '%1'" ).arg( currUser().second->allNames() ) );
+}
+
+void CSyncSystem::finishDeltaSyncRun()
+{
+    auto run = std::move( fDeltaSyncRun );
+    fDeltaSyncRun = SDeltaSyncRun();
+    if ( !run.fEnabled || !fDeltaSyncState || !fDeltaSyncState->isLoaded() || !currUser().second )
+        return;
+
+    if ( run.fFailed )
+    {
+        emit sigAddToLog( EMsgType::eWarning, tr( "Errors during the sync of '%1', the delta sync watermark was not updated" ).arg( currUser().second->allNames() ) );
+        return;
+    }
+
+    // the servers clocks may not match ours, overlapping the previous window only refetches a few items
+    static constexpr qint64 kClockSkewSecs = 10 * 60;
+
+    SDeltaSyncWatermark watermark;
+    watermark.fWatermark = run.fRunStart.addSecs( -kClockSkewSecs );
+    watermark.fRunsSinceFullRefresh = run.fIsDelta ? ( run.fRunsSinceFullRefresh + 1 ) : 0;
+    for ( auto &&ii : run.fSince )
+        fDeltaSyncState->setWatermark( ii.first, currUser().second->getUserID( ii.first ), watermark );
+
+    QString errorMsg;
+    if ( !fDeltaSyncState->save( errorMsg ) )
+        emit sigAddToLog( EMsgType::eWarning, tr( "Delta sync state could not be saved: %1" ).arg( errorMsg ) );
+}
+
+// nothing reads the image tags, EnableImages drops most of them and the limit drops the per type lists
+void CSyncSystem::addNoImagesQueryItems( std::list< std::pair< QString, QString > > &queryItems ) const
+{
+    queryItems.push_back( std::make_pair( "EnableImages", "False" ) );
+    queryItems.push_back( std::make_pair( "EnableImageTypes", "Primary" ) );
+    queryItems.push_back( std::make_pair( "ImageTypeLimit", "0" ) );
+}
+
+void CSyncSystem::addDeltaSyncQueryItems( const QString &serverName, std::list< std::pair< QString, QString > > &queryItems ) const
 {
-    handleGetMediaListResponse( serverName, data, tr( "Loading Users Media Data" ), tr( "%1 has %2 media items on server '%3'" ), tr( "Loading %2 media items" ) );
+    if ( !fDeltaSyncRun.fIsDelta )
+        return;
+
+    auto pos = fDeltaSyncRun.fSince.find( serverName );
+    if ( ( pos == fDeltaSyncRun.fSince.end() ) || !( *pos ).second.isValid() )
+        return;
+
+    // the user data save date changes for played, favorite and playback position updates, not just LastPlayedDate
+    queryItems.push_back( std::make_pair( "MinDateLastSavedForUser", ( *pos ).second.toUTC().toString( Qt::ISODate ) ) );
+}
+
+// a delta run only loads media that changed, the matching media on the other servers
+// is needed for the merge, so it is loaded by provider id once every changed list is in.
+// returns true when the merge is left to the counterpart operation
+bool CSyncSystem::requestDeltaSyncCounterparts()
+{
+    if ( !fDeltaSyncRun.fIsDelta || fDeltaSyncRun.fCounterpartsRequested || !currUser().second )
+        return false;
+    fDeltaSyncRun.fCounterpartsRequested = true;
+
+    auto operation = std::make_shared< CSyncOperation >(
+        tr( "Load Changed Media Counterparts" ), std::initializer_list< ERequestType >{ ERequestType::eGetMediaList },
+        [ this ]( const CSyncOperation &operation )
+        {
+            if ( fProgressSystem->wasCanceled() )
+                return;
+            if ( operation.failed() )
+            {
+                userMediaLoadFailed();
+                return;
+            }
+            fProgressSystem->resetProgress();
+            slotMergeMedia( ERequestType::eGetMediaList );
+        } );
+    runOperation( operation, [ this ]() { requestDeltaSyncCounterpartLists(); } );
+    return true;
+}
+
+void CSyncSystem::requestDeltaSyncCounterpartLists()
+{
+    static constexpr int kMaxProvidersPerRequest = 100;
+
+    for ( auto &&serverInfo : *fServerModel )
+    {
+        if ( !serverInfo->isEnabled() )
+            continue;
+
+        // only what the delta lists of the other servers returned, not everything the model holds
+        auto serverName = serverInfo->keyName();
+        std::set< QString > providerKeys;
+        for ( auto &&ii : fDeltaSyncRun.fChangedProviderKeys )
+        {
+            if ( ii.first != serverName )
+                providerKeys.insert( ii.second.begin(), ii.second.end() );
+        }
+
+        if ( providerKeys.empty() )
+            continue;
+
+        emit sigAddToLog( EMsgType::eInfo, tr( "Requesting media matching %1 changed provider ids from server '%2'" ).arg( providerKeys.size() ).arg( serverName ) );
+
+        QStringList keys;
+        for ( auto &&ii : providerKeys )
+        {
+            keys << ii;
+            if ( keys.count() == kMaxProvidersPerRequest )
+            {
+                requestGetMediaListForProviders( serverName, keys );
+                keys.clear();
+            }
+        }
+        if ( !keys.isEmpty() )
+            requestGetMediaListForProviders( serverName, keys );
+    }
+}
+
+void CSyncSystem::requestGetMediaListForProviders( const QString &serverName, const QStringList &providerKeys )
+{
+    std::list< std::pair< QString, QString > > queryItems = {
+        std::make_pair( "IncludeItemTypes", fSettings->getSyncItemTypes() ),   //
+        std::make_pair( "AnyProviderIdEquals", providerKeys.join( "," ) ),   //
+        std::make_pair( "Recursive", "True" ),   //
+        std::make_pair( "IsMissing", "False" ),   //
+        std::make_pair( "Fields", getItemFields( ERequestType::eGetMediaList ) ) };
+    addNoImagesQueryItems( queryItems );
+
+    // ItemsService
+    auto &&url = fServerModel->findServerInfo( serverName )->getUrl( QString( "Users/%1/Items" ).arg( currUser().second->getUserID( serverName ) ), queryItems );
+    if ( !url.isValid() )
+        return;
+
+    // qDebug().noquote().nospace() << url;
+    auto request = QNetworkRequest( url );
+
+    makeRequest( request, newRequestContext( serverName, ERequestType::eGetMediaList ) );
 }
 
 void CSyncSystem::requestMissingEpisodes( const QString &serverName, const QDate &minPremiereDate, const QDate &maxPremiereDate )
 {
-    std::list< std::pair< QString, QString > > queryItems = { std::make_pair( "IncludeItemTypes", "Episode" ), std::make_pair( "SortBy", "Type,ProductionYear,PremiereDate,SortName" ), std::make_pair( "SortOrder", "Ascending" ), std::make_pair( "Recursive", "True" ), std::make_pair( "IsMissing", "True" ), std::make_pair( "Fields", getItemFields() ) };
+    std::list< std::pair< QString, QString > > queryItems = { std::make_pair( "IncludeItemTypes", "Episode" ), std::make_pair( "SortBy", "Type,ProductionYear,PremiereDate,SortName" ), std::make_pair( "SortOrder", "Ascending" ), std::make_pair( "Recursive", "True" ), std::make_pair( "IsMissing", "True" ), std::make_pair( "Fields", getItemFields( ERequestType::eGetMissingEpisodes ) ) };
+    addNoImagesQueryItems( queryItems );
     if ( minPremiereDate.isValid() )
     {
         queryItems.emplace_back( std::make_pair( "MinPremiereDate", minPremiereDate.toString( Qt::ISODate ) ) );
@@ -1728,9 +2781,7 @@ void CSyncSystem::requestMissingEpisodes( const QString &serverName, const QDate
 
     emit sigAddToLog( EMsgType::eInfo, QString( "Requesting missing episodes from server '%2'" ).arg( serverName ) );
 
-    auto reply = makeRequest( request );
-    setServerName( reply, serverName );
-    setRequestType( reply, ERequestType::eGetMissingEpisodes );
+    makeRequest( request, newRequestContext( serverName, ERequestType::eGetMissingEpisodes ) );
 }
 
 void CSyncSystem::requestMissingTVDBid( const QString &serverName )
@@ -1738,7 +2789,8 @@ void CSyncSystem::requestMissingTVDBid( const QString &serverName )
     std::list< std::pair< QString, QString > > queryItems = {
         std::make_pair( "IncludeItemTypes", "Episode" ), std::make_pair( "SortBy", "Type,ProductionYear,PremiereDate,SortName" ), std::make_pair( "SortOrder", "Ascending" ), std::make_pair( "Recursive", "True" ),
         // std::make_pair( "IsMissing", "True" ),
-        std::make_pair( "HasTvdbId", "False" ), std::make_pair( "HasSpecialFeature", "False" ), std::make_pair( "Fields", getItemFields() ) };
+        std::make_pair( "HasTvdbId", "False" ), std::make_pair( "HasSpecialFeature", "False" ), std::make_pair( "Fields", getItemFields( ERequestType::eGetMissingTVDBid ) ) };
+    addNoImagesQueryItems( queryItems );
 
     // ItemsService
     auto &&url = fServerModel->findServerInfo( serverName )->getUrl( QString( "Users/%1/Items" ).arg( currUser().second->getUserID( serverName ) ), queryItems );
@@ -1750,24 +2802,22 @@ void CSyncSystem::requestMissingTVDBid( const QString &serverName )
 
     emit sigAddToLog( EMsgType::eInfo, QString( "Requesting missing episodes from server '%2'" ).arg( serverName ) );
 
-    auto reply = makeRequest( request );
-    setServerName( reply, serverName );
-    setRequestType( reply, ERequestType::eGetMissingTVDBid );
+    makeRequest( request, newRequestContext( serverName, ERequestType::eGetMissingTVDBid ) );
 }
 
-void CSyncSystem::handleMissingTVDBidResponse( const QString &serverName, const QByteArray &data )
+void CSyncSystem::handleMissingTVDBidResponse( const SRequestContext &context )
 {
-    handleGetMediaListResponse( serverName, data, tr( "Loading Users Missing TVDBid Media Data" ), tr( "Server '%1' has %2 missing TVDBid episodes" ), tr( "Loading %2 missing TVDBid episodes" ) );
+    logStreamedItems( context, tr( "Server '%1' has %2 missing TVDBid episodes" ), tr( "Loading %2 missing TVDBid episodes" ) );
 }
 
-void CSyncSystem::handleMissingEpisodesResponse( const QString &serverName, const QByteArray &data )
+void CSyncSystem::handleMissingEpisodesResponse( const SRequestContext &context )
 {
-    handleGetMediaListResponse( serverName, data, tr( "Loading Users Missing Media Data" ), tr( "Server '%1' has %2 missing episodes" ), tr( "Loading %2 missing episodes" ) );
+    logStreamedItems( context, tr( "Server '%1' has %2 missing episodes" ), tr( "Loading %2 missing episodes" ) );
 }
 
-void CSyncSystem::handleAllMoviesResponse( const QString &serverName, const QByteArray &data )
+void CSyncSystem::handleAllMoviesResponse( const SRequestContext &context )
 {
-    handleGetMediaListResponse( serverName, data, tr( "Loading All Movies" ), tr( "Server '%1' has %2 movies" ), tr( "Loading %2 movies" ) );
+    logStreamedItems( context, tr( "Server '%1' has %2 movies" ), tr( "Loading %2 movies" ) );
 }
 
 void CSyncSystem::requestAllMovies( const QString &serverName )
@@ -1776,7 +2826,8 @@ void CSyncSystem::requestAllMovies( const QString &serverName )
         std::make_pair( "IncludeItemTypes", "Movie" ),   //
         std::make_pair( "SortBy", "Type,ProductionYear,PremiereDate,SortName" ),   //
         std::make_pair( "SortOrder", "Ascending" ), std::make_pair( "Recursive", "True" ),   //
-        std::make_pair( "Fields", getItemFields() ) };
+        std::make_pair( "Fields", getItemFields( ERequestType::eGetAllMovies ) ) };
+    addNoImagesQueryItems( queryItems );
 
     // ItemsService
     auto &&url = fServerModel->findServerInfo( serverName )->getUrl( QString( "Users/%1/Items" ).arg( currUser().second->getUserID( serverName ) ), queryItems );
@@ -1788,9 +2839,7 @@ void CSyncSystem::requestAllMovies( const QString &serverName )
 
     emit sigAddToLog( EMsgType::eInfo, QString( "Requesting all movies from server '%2'" ).arg( serverName ) );
 
-    auto reply = makeRequest( request );
-    setServerName( reply, serverName );
-    setRequestType( reply, ERequestType::eGetAllMovies );
+    makeRequest( request, newRequestContext( serverName, ERequestType::eGetAllMovies ) );
 }
 
 bool CSyncSystem::requestCreateCollection( const QString &serverName, const QString &collectionName, const std::list< std::shared_ptr< CMediaData > > &items )
@@ -1824,9 +2873,7 @@ bool CSyncSystem::requestCreateCollection( const QString &serverName, const QStr
 
     emit sigAddToLog( EMsgType::eInfo, QString( "Requesting to create media collection '%1' with '%3' media items on server '%2'" ).arg( collectionName ).arg( serverName ).arg( ids.count() ) );
 
-    auto reply = makeRequest( request, ENetworkRequestType::ePost );
-    setServerName( reply, serverName );
-    setRequestType( reply, ERequestType::eCreateCollection );
+    makeRequest( request, newRequestContext( serverName, ERequestType::eCreateCollection ), ENetworkRequestType::ePost );
     return true;
 }
 
@@ -1856,9 +2903,7 @@ void CSyncSystem::requestAllCollections( const QString &serverName )
 
     emit sigAddToLog( EMsgType::eInfo, QString( "Requesting all media folders from server '%2'" ).arg( serverName ) );
 
-    auto reply = makeRequest( request );
-    setServerName( reply, serverName );
-    setRequestType( reply, ERequestType::eGetAllCollections );
+    makeRequest( request, newRequestContext( serverName, ERequestType::eGetAllCollections ) );
 }
 
 void CSyncSystem::handleAllCollectionsResponse( const QString &serverName, const QByteArray &data )
@@ -1907,6 +2952,7 @@ void CSyncSystem::handleAllCollectionsResponse( const QString &serverName, const
 void CSyncSystem::requestAllCollectionsEx( const QString &serverName, const QString &folderName, const QString &folderId )
 {
     std::list< std::pair< QString, QString > > queryItems = { std::make_pair( "ParentId", folderId ), std::make_pair( "Recursive", "False" ) };
+    addNoImagesQueryItems( queryItems );
 
     // ItemsService
     auto &&url = fServerModel->findServerInfo( serverName )->getUrl( QString( "Items" ), queryItems );
@@ -1918,10 +2964,9 @@ void CSyncSystem::requestAllCollectionsEx( const QString &serverName, const QStr
 
     emit sigAddToLog( EMsgType::eInfo, QString( "Requesting collections from folder '%1(%2)' from server '%3'" ).arg( folderName ).arg( folderId ).arg( serverName ) );
 
-    auto reply = makeRequest( request );
-    setServerName( reply, serverName );
-    setRequestType( reply, ERequestType::eGetAllCollectionsEx );
-    setExtraData( reply, QStringList() << folderName << folderId );
+    auto context = newRequestContext( serverName, ERequestType::eGetAllCollectionsEx );
+    context->fNameAndID = { folderName, folderId };
+    makeRequest( request, context );
 }
 
 void CSyncSystem::handleAllCollectionsExResponse( const QString &serverName, const QByteArray &data, const QString &folderName, const QString &folderId )
@@ -1965,6 +3010,7 @@ void CSyncSystem::handleAllCollectionsExResponse( const QString &serverName, con
 void CSyncSystem::requestGetCollection( const QString &serverName, const QString &collectionName, const QString &collectionId )
 {
     std::list< std::pair< QString, QString > > queryItems = { std::make_pair( "ParentId", collectionId ), std::make_pair( "Recursive", "False" ), std::make_pair( "IncludeItemTypes", "Movie" ), std::make_pair( "SortBy", "Type,ProductionYear,PremiereDate,SortName" ), std::make_pair( "SortOrder", "Ascending" ), std::make_pair( "Fields", "Path,ProviderIds,ExternalUrls,Missing,ProductionYear,PremiereDate,DateCreated,EndDate,StartDate,OriginalTitle" ) };
+    addNoImagesQueryItems( queryItems );
 
     // ItemsService
     auto &&url = fServerModel->findServerInfo( serverName )->getUrl( QString( "Items" ), queryItems );
@@ -1976,10 +3022,9 @@ void CSyncSystem::requestGetCollection( const QString &serverName, const QString
 
     emit sigAddToLog( EMsgType::eInfo, QString( "Requesting collection %1(%2) from server '%3'" ).arg( collectionName ).arg( collectionId ).arg( serverName ) );
 
-    auto reply = makeRequest( request );
-    setServerName( reply, serverName );
-    setRequestType( reply, ERequestType::eGetCollection );
-    setExtraData( reply, QStringList() << collectionName << collectionId );
+    auto context = newRequestContext( serverName, ERequestType::eGetCollection );
+    context->fNameAndID = { collectionName, collectionId };
+    makeRequest( request, context );
 }
 
 void CSyncSystem::handleGetCollectionResponse( const QString &serverName, const QString &collectionName, const QString &collectionId, const QByteArray &data )
@@ -1997,25 +3042,88 @@ void CSyncSystem::requestReloadMediaItemData( const QString &serverName, const Q
     requestReloadMediaItemData( serverName, mediaData );
 }
 
-void CSyncSystem::requestReloadMediaItemData( const QString &serverName, std::shared_ptr< CMediaData > mediaData )
+void CSyncSystem::requestReloadMediaItemData( const QString &serverName, const std::shared_ptr< CMediaData > &mediaData )
 {
-    // UserLibraryService
-    auto &&url = fServerModel->findServerInfo( serverName )->getUrl( QString( "Users/%1/Items/%2" ).arg( currUser().second->getUserID( serverName ) ).arg( mediaData->getMediaID( serverName ) ), {} );
+    if ( !mediaData || !currUser().second )
+        return;
+
+    auto mediaID = mediaData->getMediaID( serverName );
+    auto userID = currUser().second->getUserID( serverName );
+    if ( mediaID.isEmpty() || userID.isEmpty() )
+        return;
+
+    // reloads are collected for a short window and sent as one query per chunk of ids
+    fPendingReloads[ { serverName, userID } ].insert( mediaID );
+    if ( !fReloadTimer )
+    {
+        fReloadTimer = new QTimer( this );
+        fReloadTimer->setSingleShot( true );
+        fReloadTimer->setInterval( 250 );
+        connect( fReloadTimer, &QTimer::timeout, this, &CSyncSystem::slotSendPendingReloads );
+    }
+    if ( !fReloadTimer->isActive() )
+        fReloadTimer->start();
+}
+
+void CSyncSystem::slotSendPendingReloads()
+{
+    static constexpr int kMaxIDsPerRequest = 100;
+
+    auto pendingReloads = std::move( fPendingReloads );
+    fPendingReloads.clear();
+
+    for ( auto &&ii : pendingReloads )
+    {
+        auto &&serverName = ii.first.first;
+        auto &&userID = ii.first.second;
+        auto serverInfo = fServerModel->findServerInfo( serverName );
+        if ( !serverInfo )
+            continue;
+
+        QStringList ids;
+        for ( auto &&mediaID : ii.second )
+        {
+            ids << mediaID;
+            if ( ids.count() == kMaxIDsPerRequest )
+            {
+                requestReloadMediaItemData( serverInfo, userID, ids );
+                ids.clear();
+            }
+        }
+        if ( !ids.isEmpty() )
+            requestReloadMediaItemData( serverInfo, userID, ids );
+    }
+
+    if ( !isRunning() )
+    {
+        fProgressSystem->resetProgress();
+        if ( currUser().second && !pendingReloads.empty() )
+        {
+            finishDeltaSyncRun();
+            emit sigProcessingFinished( currUser().second->userName( ( *pendingReloads.begin() ).first.first ) );
+        }
+    }
+}
+
+void CSyncSystem::requestReloadMediaItemData( std::shared_ptr< const CServerInfo > serverInfo, const QString &userID, const QStringList &mediaIDs )
+{
+    std::list< std::pair< QString, QString > > queryItems = { std::make_pair( "Ids", mediaIDs.join( "," ) ), std::make_pair( "Fields", getItemFields( ERequestType::eReloadMediaData ) ) };
+    addNoImagesQueryItems( queryItems );
+
+    // ItemsService, the user specific endpoint is used so the UserData returned is for the current user
+    auto &&url = serverInfo->getUrl( QString( "Users/%1/Items" ).arg( userID ), queryItems );
     if ( !url.isValid() )
         return;
 
     // qDebug() << url;
     auto request = QNetworkRequest( url );
 
-    auto reply = makeRequest( request );
-
-    setServerName( reply, serverName );
-    setRequestType( reply, ERequestType::eReloadMediaData );
-    setExtraData( reply, mediaData->getMediaID( serverName ) );
-    // qDebug() << "Media Data for " << mediaData->name() << reply;
+    auto context = newRequestContext( serverInfo->keyName(), ERequestType::eReloadMediaData );
+    context->fIDs = mediaIDs;
+    makeRequest( request, context );
 }
 
-void CSyncSystem::handleReloadMediaResponse( const QString &serverName, const QByteArray &data, const QString &itemID )
+void CSyncSystem::handleReloadMediaResponse( const QString &serverName, const QByteArray &data, const QStringList &itemIDs )
 {
     QJsonParseError error;
     auto doc = QJsonDocument::fromJson( data, &error );
@@ -2026,17 +3134,39 @@ void CSyncSystem::handleReloadMediaResponse( const QString &serverName, const QB
         return;
     }
 
-    auto mediaData = doc.object();
-    fMediaModel->reloadMedia( serverName, mediaData, itemID );
+    if ( !doc[ "Items" ].isArray() )
+    {
+        if ( itemIDs.count() == 1 )
+            fMediaModel->reloadMedia( serverName, doc.object(), itemIDs.front() );
+        return;
+    }
+
+    auto mediaList = doc[ "Items" ].toArray();
+    if ( mediaList.count() != itemIDs.count() )
+        emit sigAddToLog( EMsgType::eWarning, tr( "Requested %1 media items to reload from server '%2', received %3" ).arg( itemIDs.count() ).arg( serverName ).arg( mediaList.count() ) );
+
+    for ( auto &&ii : mediaList )
+    {
+        auto mediaData = ii.toObject();
+        fMediaModel->reloadMedia( serverName, mediaData, mediaData[ "Id" ].toString() );
+    }
 }
 
 void CSyncSystem::slotCanceled()
 {
-    auto tmp = fAttributes;
-    for ( auto &&ii : tmp )
-    {
-        ii.first->abort();
-    }
+    fPlanExecutor.reset();
+    fPendingReloads.clear();
+    fDeltaSyncRun = SDeltaSyncRun();
+
+    auto neverSent = fRequestScheduler->clear();
+    for ( auto &&ii : neverSent )
+        abandonRequest( ii.fContext );
+
+    std::list< QNetworkReply * > replies;
+    for ( auto &&ii : fReplyContexts )
+        replies.push_back( ii.first );
+    for ( auto &&ii : replies )
+        ii->abort();
     clearCurrUser();
 }
 
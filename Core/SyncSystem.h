@@ -35,6 +35,7 @@
 #include "SABUtils/HashUtils.h"
 
 #include <memory>
+#include <map>
 #include <set>
 
 class CUsersModel;
@@ -43,6 +44,8 @@ class CServerModel;
 class CCollectionsModel;
 
 class QNetworkReply;
+class QJsonArray;
+class QJsonObject;
 class QAuthenticator;
 class QSslPreSharedKeyAuthenticator;
 class QNetworkProxy;
@@ -51,10 +54,23 @@ class QNetworkAccessManager;
 class CUserData;
 class CMediaData;
 struct SMediaServerData;
+struct SUserDataChange;
+class CUserDataEchoFilter;
 class CSettings;
 class CProgressSystem;
 class QTimer;
 class CServerInfo;
+class CRequestScheduler;
+class CDeltaSyncState;
+struct SPendingRequest;
+struct SRequestContext;
+class CRequestContextPool;
+class CSyncOperation;
+class CResponseParser;
+class CSyncPlan;
+class CSyncPlanExecutor;
+struct SSyncMutation;
+class QJsonDocument;
 struct SUserServerData;
 
 enum class ETool
@@ -68,6 +84,8 @@ enum class ETool
     eMissingCollections
 };
 
+QString toString( ETool tool );
+
 enum class ERequestType
 {
     eNone,
@@ -79,6 +97,7 @@ enum class ERequestType
     eGetUserAvatar,
     eSetUserAvatar,
     eGetMediaList,
+    eGetUserDataList,
     eReloadMediaData,
     eUpdateUserMediaData,
     eUpdateFavorite,
@@ -119,6 +138,38 @@ struct SServerReplyInfo
     QString fExtraData;
 };
 
+struct SMediaListPagingInfo
+{
+    int fNextStartIndex{ 0 };
+    int fTotalRecordCount{ -1 };   // -1 until the first page has been received
+    int fPageSize{ 0 };   // adapted as pages come back
+    int fPagesInFlight{ 0 };
+    int fItemsLoaded{ 0 };
+    bool fTotalFromServer{ false };   // fTotalRecordCount came from the server rather than a short page
+    std::unordered_set< QString > fIDsReceived;   // compared to the total, the list changed while it was being paged when they differ
+};
+
+// the play state lists for one server, a sparse load makes one request per filter
+struct SUserDataListInfo
+{
+    int fPending{ 0 };   // lists that have not come back
+    int fItemsLoaded{ 0 };
+    std::set< QString > fMissingIDs;   // items the catalog does not have
+    bool fGapsRequested{ false };   // sparse, the items other servers returned have been asked for by ID
+};
+
+struct SDeltaSyncRun
+{
+    bool fEnabled{ false };   // the watermarks are updated when the run finishes cleanly
+    bool fIsDelta{ false };   // only media changed since the watermark is being loaded
+    bool fCounterpartsRequested{ false };
+    bool fFailed{ false };
+    QDateTime fRunStart;
+    int fRunsSinceFullRefresh{ 0 };
+    std::map< QString, QDateTime > fSince;   // serverName -> watermark used for this run
+    std::map< QString, std::set< QString > > fChangedProviderKeys;   // serverName -> "provider.id" of the media its delta lists returned
+};
+
 struct SConnectIDInfo
 {
     QString fServerName;   // empty means apply to all servers
@@ -126,11 +177,6 @@ struct SConnectIDInfo
     std::shared_ptr< CUserData > fUserData;
 };
 
-constexpr int kServerName = QNetworkRequest::User + 1;   // QString
-constexpr int kRequestType = QNetworkRequest::User + 2;   // ERequestType
-constexpr int kExtraData = QNetworkRequest::User + 3;   // QVariant
-
-using TMediaIDToMediaData = std::map< QString, std::shared_ptr< CMediaData > >;
 enum EMsgType
 {
     eError,
@@ -150,10 +196,23 @@ public:
     CSyncSystem(
         std::shared_ptr< CSettings > settings, std::shared_ptr< CUsersModel > usersModel, std::shared_ptr< CMediaModel > mediaModel, std::shared_ptr< CCollectionsModel > collectionsModel, std::shared_ptr< CServerModel > serverModel,
         QObject *parent = nullptr );
+    ~CSyncSystem();
 
     void setProcessNewMediaFunc( std::function< void( std::shared_ptr< CMediaData > userData ) > processMediaFunc );
     void setUserMsgFunc( std::function< void( EMsgType msgType, const QString &title, const QString &msg ) > userMsgFunc );
     void setProgressSystem( std::shared_ptr< CProgressSystem > funcs );
+    void setDeltaSyncAllowed( bool allowed ) { fDeltaSyncAllowed = allowed; }
+    // the catalog loaded for the first user is kept, later users only load their play state onto it
+    void setSharedCatalog( bool shared ) { fSharedCatalog = shared; }
+    // shared by every sync system of the process, so the events for the writes of any of them are dropped
+    void setEchoFilter( std::shared_ptr< CUserDataEchoFilter > echoFilter ) { fEchoFilter = echoFilter; }
+    // shared by every sync system of the process, so parallel jobs do not save over each other's watermarks
+    void setDeltaSyncState( std::shared_ptr< CDeltaSyncState > deltaSyncState ) { fDeltaSyncState = deltaSyncState; }
+    void invalidateSharedCatalog()   // the next user reloads the full media list
+    {
+        fCatalogLoaded = false;
+        fCatalogUser.reset();
+    }
 
     void testServers( const std::vector< std::shared_ptr< const CServerInfo > > &serverInfo );
     void testServer( std::shared_ptr< const CServerInfo > serverInfo );
@@ -193,11 +252,13 @@ public:
     void requestGetUserAvatar( const QString &serverName, const QString &userID );
     void requestSetUserAvatar( const QString &serverName, const QString &userID, const QImage &image );
 
-    void updateUserDataForMedia( const QString &serverName, std::shared_ptr< CMediaData > mediaData, std::shared_ptr< SMediaServerData > newData );
+    void updateUserDataForMedia( const QString &serverName, const std::shared_ptr< CMediaData > &mediaData, const std::shared_ptr< SMediaServerData > &newData );
     void updateUserData( const QString &serverName, std::shared_ptr< CUserData > userData, std::shared_ptr< SUserServerData > newData );
     ;
+    void syncUserDataChange( const SUserDataChange &change );   // copies one item's user data to the other servers, changes are run one at a time
 
     void selectiveProcessMedia( const QString &selectedServer );
+    CSyncPlan buildSyncPlan( const QString &selectedServer ) const;   // what selectiveProcessMedia would change, the CLI dry run prints it
     void selectiveProcessUsers( const QString &selectedServer );
 
     void findMovieOnServer( const QString &movieName, int year );
@@ -219,19 +280,14 @@ public Q_SLOTS:
     void slotCanceled();
 
 private:
-    bool processMedia( std::shared_ptr< CMediaData > mediaData, const QString &selectedServer );
+    void executeSyncPlan( const CSyncPlan &plan );
     bool processUser( std::shared_ptr< CUserData > userData, const QString &selectedServer );
 
-    void setServerName( QNetworkReply *reply, const QString &serverName );
-    QString serverName( QNetworkReply *reply );
-
-    void setRequestType( QNetworkReply *reply, ERequestType requestType );
-    QString hostName( QNetworkReply *reply );
+    QString hostName( const QUrl &url );
 
-    ERequestType requestType( QNetworkReply *reply );
-
-    void setExtraData( QNetworkReply *reply, QVariant extraData );
-    QVariant extraData( QNetworkReply *reply );
+    SRequestContext *newRequestContext( const QString &serverName, ERequestType requestType );
+    SRequestContext *takeRequestContext( QNetworkReply *reply );
+    SRequestContext *streamContext( quint64 ticket ) const;
 
 private Q_SLOTS:
     void slotRequestFinished( QNetworkReply *reply );
@@ -245,21 +301,36 @@ private Q_SLOTS:
 
     void slotCheckPendingRequests();
     void slotRepairNextUser();
+    void slotSendPendingReloads();
 
 private:
-    QString getItemFields() const;
+    ETool itemFieldsTool( ERequestType requestType ) const;
+    QString getItemFields( ERequestType requestType ) const;
+    void addItemFieldsBytes( ERequestType requestType, qint64 numBytes );
+    void logItemFieldsBytes();
     std::shared_ptr< CUserData > findFirstAdminUser( std::shared_ptr< const CServerInfo > serverInfo ) const;
-    QNetworkReply *makeRequest( QNetworkRequest &request, ENetworkRequestType requestType = ENetworkRequestType::eGet, const QByteArray &data = {}, QString contentType = QString() );
+    void makeRequest( QNetworkRequest &request, SRequestContext *context, ENetworkRequestType networkRequestType = ENetworkRequestType::eGet, const QByteArray &data = {}, QString contentType = QString() );
+    QNetworkReply *sendRequest( const SPendingRequest &pendingRequest );
 
     std::shared_ptr< CUserData > loadUser( const QString &serverName, const QJsonObject &user );
 
-    void postHandleRequest( QNetworkReply *reply, const QString &serverName, ERequestType requestType );
-    void decRequestCount( QNetworkReply *reply, ERequestType requestType );
+    void postHandleRequest( SRequestContext *context, bool aOK );
+    void abandonRequest( SRequestContext *context );   // the request will never be sent
+    void releaseRequestContext( SRequestContext *context );
+    void decRequestCount( const SRequestContext *context );
 
-    bool isLastRequestOfType( ERequestType type ) const;
+    void runOperation( std::shared_ptr< CSyncOperation > operation, std::function< void() > makeRequests );
+    std::shared_ptr< CSyncOperation > newMediaOperation( const QString &name, ERequestType requestType );
 
     bool handleError( QNetworkReply *reply, const QString &serverName, QString &errorMsg, bool reportMsg );
     std::list< std::shared_ptr< CMediaData > > handleGetMediaListResponse( const QString &serverName, const QByteArray &data, const QString &progressTitle, const QString &logMsg, const QString &partialLogMsg );
+    std::list< std::shared_ptr< CMediaData > > handleGetMediaListResponse( const QString &serverName, const QJsonDocument &doc, const QString &progressTitle, const QString &logMsg, const QString &partialLogMsg );
+    bool isStreamedItemsRequest( ERequestType requestType ) const;
+    void readItemsStream( QNetworkReply *reply );
+    void handleStreamedItems( SRequestContext *context, const QJsonArray &items );
+    void handleStreamedResponse( SRequestContext *context, const QJsonObject &header, bool isItemList, const QString &errorMsg );
+    void logStreamedItems( const SRequestContext &context, const QString &logMsg, const QString &partialLogMsg );
+    std::list< std::shared_ptr< CMediaData > > loadMediaList( const QString &serverName, const QJsonArray &mediaList, int maxItems, const QString &progressTitle, const QString &logMsg, const QString &partialLogMsg );
 
     void requestGetServerInfo( const QString &serverName );
     void handleGetServerInfoResponse( const QString &serverName, const QByteArray &data );
@@ -279,18 +350,41 @@ private:
     void handleGetUserAvatarResponse( const QString &serverName, const QString &userID, const QByteArray &data );
     void handleSetUserAvatarResponse( const QString &serverName, const QString &userID );
 
-    void requestGetMediaList( const QString &serverName );
-
-    void handleGetMediaListResponse( const QString &serverName, const QByteArray &data );
+    void requestGetMediaList( const QString &serverName, bool allowPaging = true );
+    void requestGetMediaListPage( const QString &serverName, int startIndex, int limit );
+    void requestNextMediaListPages( const QString &serverName );
+
+    void handleGetMediaListResponse( const SRequestContext &context, const QJsonObject &header );
+    void handleGetMediaListPageResponse( const SRequestContext &context, const QJsonObject &header );
+
+    void loadUserDataForCatalog( ETool tool, std::shared_ptr< CUserData > userData );
+    void requestGetUserDataList( const QString &serverName );
+    void requestGetUserDataList( const QString &serverName, const std::pair< QString, QString > &filter );
+    void handleGetUserDataListResponse( const SRequestContext &context );
+    void requestSparseUserDataGaps();
+    void finishUserDataList( const QString &serverName );
+    void requestGetMediaListForIDs( const QString &serverName, const QStringList &mediaIDs );
+
+    void processNextUserDataChange();
+    void finishUserDataChange( const SUserDataChange &change, const QString &mediaName, bool changed, bool aOK );
+
+    void startDeltaSyncRun( ETool tool );
+    void finishDeltaSyncRun();
+    void addNoImagesQueryItems( std::list< std::pair< QString, QString > > &queryItems ) const;
+    void addDeltaSyncQueryItems( const QString &serverName, std::list< std::pair< QString, QString > > &queryItems ) const;
+    bool requestDeltaSyncCounterparts();
+    void userMediaLoadFailed();
+    void requestDeltaSyncCounterpartLists();
+    void requestGetMediaListForProviders( const QString &serverName, const QStringList &providerKeys );
 
     void requestMissingTVDBid( const QString &serverName );
-    void handleMissingTVDBidResponse( const QString &serverName, const QByteArray &data );
+    void handleMissingTVDBidResponse( const SRequestContext &context );
 
     void requestMissingEpisodes( const QString &serverName, const QDate &minPremiereDate, const QDate &maxPremiereDate );
-    void handleMissingEpisodesResponse( const QString &serverName, const QByteArray &data );
+    void handleMissingEpisodesResponse( const SRequestContext &context );
 
     void requestAllMovies( const QString &serverName );
-    void handleAllMoviesResponse( const QString &serverName, const QByteArray &data );
+    void handleAllMoviesResponse( const SRequestContext &context );
 
     bool requestCreateCollection( const QString &serverName, const QString &collectionName, const std::list< std::shared_ptr< CMediaData > > &items );
     void handleCreateCollection( const QString &serverName, const QByteArray &data );
@@ -305,14 +399,17 @@ private:
     void handleGetCollectionResponse( const QString &serverName, const QString &collectionName, const QString &collectionId, const QByteArray &data );
 
     void requestReloadMediaItemData( const QString &serverName, const QString &mediaID );
-    void requestReloadMediaItemData( const QString &serverName, std::shared_ptr< CMediaData > mediaData );
-    void requestSetFavorite( const QString &serverName, std::shared_ptr< CMediaData > mediaData, std::shared_ptr< SMediaServerData > newData );
+    void requestReloadMediaItemData( const QString &serverName, const std::shared_ptr< CMediaData > &mediaData );
+    void requestReloadMediaItemData( std::shared_ptr< const CServerInfo > serverInfo, const QString &userID, const QStringList &mediaIDs );
+    bool requestSetFavorite( const QString &serverName, const std::shared_ptr< CMediaData > &mediaData, const std::shared_ptr< SMediaServerData > &newData, int mutationIndex = -1 );
     void handleSetFavorite( const QString &serverName, const QString &mediaID );
 
-    void requestUpdateUserDataForMedia( const QString &serverName, std::shared_ptr< CMediaData > mediaData, std::shared_ptr< SMediaServerData > newData );
+    bool requestUpdateUserDataForMedia( const QString &serverName, const std::shared_ptr< CMediaData > &mediaData, const std::shared_ptr< SMediaServerData > &newData, int mutationIndex = -1 );
+    int issueSyncMutation( size_t index, const SSyncMutation &mutation );
+    void reportSyncPlanResults( const CSyncPlanExecutor &executor );
     void handleUpdateUserDataForMedia( const QString &serverName, const QString &mediaID );
 
-    void handleReloadMediaResponse( const QString &serverName, const QByteArray &data, const QString &id );
+    void handleReloadMediaResponse( const QString &serverName, const QByteArray &data, const QStringList &ids );
 
     void requestUpdateUserData( const QString &serverName, std::shared_ptr< CUserData > userData, std::shared_ptr< SUserServerData > newData );
     void handleUpdateUserData( const QString &serverName, const QString &userID );
@@ -334,11 +431,20 @@ private:
     std::shared_ptr< CCollectionsModel > fCollectionsModel;
     std::shared_ptr< CServerModel > fServerModel;
     QNetworkAccessManager *fManager{ nullptr };
+    std::unique_ptr< CRequestScheduler > fRequestScheduler;
+    std::unique_ptr< CRequestContextPool > fRequestContextPool;
+    CResponseParser *fResponseParser{ nullptr };   // JSON parsing for large responses runs on its worker thread
 
     QTimer *fPendingRequestTimer{ nullptr };
+    QTimer *fReloadTimer{ nullptr };
+    std::map< std::pair< QString, QString >, std::set< QString > > fPendingReloads;   // ( serverName, userID ) -> media IDs waiting to be reloaded
 
     std::unordered_map< ERequestType, std::unordered_map< QString, int > > fRequests;   // request type -> host -> count
-    std::unordered_map< QNetworkReply *, std::unordered_map< int, QVariant > > fAttributes;
+    std::unordered_map< QNetworkReply *, SRequestContext * > fReplyContexts;   // requests in flight
+    std::unordered_map< quint64, SRequestContext * > fStreamContexts;   // stream ticket -> context, until the items are read or the context is released
+    std::shared_ptr< CSyncOperation > fActiveOperation;   // owns the requests being made right now
+    std::unique_ptr< CSyncPlanExecutor > fPlanExecutor;   // the sync plan being run
+    std::map< ETool, std::pair< qint64, int > > fItemFieldsBytes;   // field profile -> ( bytes, responses ) for the Items queries
 
     std::function< void( std::shared_ptr< CMediaData > mediaData ) > fProcessNewMediaFunc;
     std::function< void( EMsgType type, const QString &title, const QString &msg ) > fUserMsgFunc;
@@ -346,6 +452,18 @@ private:
 
     using TOptionalBoolPair = std::pair< std::optional< bool >, std::optional< bool > >;
     std::unordered_map< QString, TOptionalBoolPair > fLeftAndRightFinished;
+    std::unordered_map< QString, SMediaListPagingInfo > fMediaListPaging;   // serverName -> paging state for the current media list load
+    std::unordered_map< QString, SUserDataListInfo > fUserDataLists;   // serverName -> play state lists for the current load
+    std::list< SUserDataChange > fUserDataChanges;   // waiting for the one being synced
+    bool fUserDataChangeRunning{ false };
+    std::pair< int, qint64 > fUserDataChangeLatency{ 0, 0 };   // changes synced, total msecs from the event to the last update
+    std::shared_ptr< CUserDataEchoFilter > fEchoFilter;
+    std::shared_ptr< CDeltaSyncState > fDeltaSyncState;
+    SDeltaSyncRun fDeltaSyncRun;
+    bool fDeltaSyncAllowed{ false };
+    bool fSharedCatalog{ false };
+    bool fCatalogLoaded{ false };   // a full media list has been loaded and merged for the shared catalog
+    std::shared_ptr< CUserData > fCatalogUser;   // whose play state the shared catalog holds, their next load is a delta
     std::unordered_map< QString, std::shared_ptr< const CServerInfo > > fTestServers;
     std::list< SConnectIDInfo > fUsersNeedingConnectIDUpdates;
     std::pair< ETool, std::shared_ptr< CUserData > > fCurrUserData{ ETool::eNone, {} };
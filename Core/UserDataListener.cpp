@@ -0,0 +1,231 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "UserDataListener.h"
+#include "ServerInfo.h"
+#include "ServerModel.h"
+#include "SyncSystem.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSysInfo>
+#include <QTimer>
+#include <QWebSocket>
+
+#include <algorithm>
+
+static constexpr int kReconnectMSecs = 30 * 1000;
+
+CUserDataEchoFilter::CUserDataEchoFilter( qint64 ttlMSecs ) :
+    fTTLMSecs( ttlMSecs )
+{
+}
+
+void CUserDataEchoFilter::addWrite( const QString &serverName, const QString &userID, const QString &mediaID, qint64 nowMSecs )
+{
+    prune( nowMSecs );
+    fWrites[ std::make_tuple( serverName, mediaID, userID ) ] = nowMSecs + fTTLMSecs;
+}
+
+bool CUserDataEchoFilter::isEcho( const SUserDataChange &change )
+{
+    // kept until it expires, a play state and a favorite write of the same item each come back as an event
+    prune( change.fReceivedMSecs );
+    return fWrites.find( std::make_tuple( change.fServerName, change.fMediaID, change.fUserID ) ) != fWrites.end();
+}
+
+void CUserDataEchoFilter::prune( qint64 nowMSecs )
+{
+    for ( auto pos = fWrites.begin(); pos != fWrites.end(); )
+    {
+        if ( ( *pos ).second <= nowMSecs )
+            pos = fWrites.erase( pos );
+        else
+            ++pos;
+    }
+}
+
+CUserDataListener::CUserDataListener( std::shared_ptr< CServerModel > serverModel, QObject *parent ) :
+    QObject( parent ),
+    fServerModel( serverModel ),
+    fReconnectMSecs( kReconnectMSecs )
+{
+}
+
+CUserDataListener::~CUserDataListener()
+{
+    stop();
+}
+
+QUrl CUserDataListener::webSocketUrl( const QString &serverName, std::shared_ptr< CServerModel > serverModel )
+{
+    auto serverInfo = serverModel ? serverModel->findServerInfo( serverName ) : std::shared_ptr< const CServerInfo >();
+    if ( !serverInfo )
+        return {};
+
+    // the device id only has to be stable, so the server reuses the session when reconnecting
+    auto deviceID = QString( "%1-%2" ).arg( QCoreApplication::applicationName() ).arg( QSysInfo::machineHostName() );
+    auto retVal = serverInfo->getUrl( "embywebsocket", { std::make_pair( "deviceId", deviceID ) } );
+    retVal.setScheme( ( retVal.scheme() == "https" ) ? "wss" : "ws" );
+    return retVal;
+}
+
+void CUserDataListener::start()
+{
+    fStopping = false;
+    for ( auto &&serverInfo : *fServerModel )
+    {
+        if ( !serverInfo->isEnabled() )
+            continue;
+        addServer( serverInfo->keyName(), webSocketUrl( serverInfo->keyName(), fServerModel ) );
+    }
+}
+
+void CUserDataListener::addServer( const QString &serverName, const QUrl &url )
+{
+    if ( !url.isValid() || ( fConnections.find( serverName ) != fConnections.end() ) )
+        return;
+
+    fStopping = false;
+    auto &&connection = fConnections[ serverName ];
+    connection.fUrl = url;
+
+    connection.fSocket = new QWebSocket( QString(), QWebSocketProtocol::VersionLatest, this );
+    connect( connection.fSocket, &QWebSocket::connected, this, [ this, serverName ]() { emit sigAddToLog( EMsgType::eInfo, tr( "Listening for play state changes on server '%1'" ).arg( serverName ) ); } );
+    connect( connection.fSocket, &QWebSocket::textMessageReceived, this, [ this, serverName ]( const QString &message ) { handleMessage( serverName, message ); } );
+    connect(
+        connection.fSocket, &QWebSocket::disconnected, this,
+        [ this, serverName ]()
+        {
+            auto pos = fConnections.find( serverName );
+            if ( fStopping || ( pos == fConnections.end() ) )
+                return;
+
+            ( *pos ).second.fKeepAliveTimer->stop();
+            emit sigAddToLog( EMsgType::eWarning, tr( "Lost the play state connection to server '%1': %2, retrying in %3 seconds" ).arg( serverName ).arg( ( *pos ).second.fSocket->errorString() ).arg( fReconnectMSecs / 1000.0 ) );
+            ( *pos ).second.fReconnectTimer->start();
+        } );
+
+    connection.fKeepAliveTimer = new QTimer( this );
+    connect( connection.fKeepAliveTimer, &QTimer::timeout, this, [ this, serverName ]() { sendMessage( serverName, "KeepAlive" ); } );
+
+    connection.fReconnectTimer = new QTimer( this );
+    connection.fReconnectTimer->setSingleShot( true );
+    connection.fReconnectTimer->setInterval( fReconnectMSecs );
+    connect( connection.fReconnectTimer, &QTimer::timeout, this, [ this, serverName ]() { open( serverName ); } );
+
+    open( serverName );
+}
+
+void CUserDataListener::stop()
+{
+    fStopping = true;
+    for ( auto &&ii : fConnections )
+    {
+        ii.second.fKeepAliveTimer->stop();
+        ii.second.fReconnectTimer->stop();
+        ii.second.fSocket->close();
+        ii.second.fSocket->deleteLater();
+        ii.second.fKeepAliveTimer->deleteLater();
+        ii.second.fReconnectTimer->deleteLater();
+    }
+    fConnections.clear();
+}
+
+void CUserDataListener::open( const QString &serverName )
+{
+    auto pos = fConnections.find( serverName );
+    if ( fStopping || ( pos == fConnections.end() ) )
+        return;
+
+    ( *pos ).second.fSocket->open( ( *pos ).second.fUrl );
+}
+
+void CUserDataListener::handleMessage( const QString &serverName, const QString &message )
+{
+    auto receivedMSecs = QDateTime::currentMSecsSinceEpoch();
+
+    auto doc = QJsonDocument::fromJson( message.toUtf8() );
+    auto messageType = doc[ "MessageType" ].toString();
+    if ( messageType == "ForceKeepAlive" )
+    {
+        // the server drops the session when no KeepAlive arrives within the timeout it sends, in seconds
+        auto pos = fConnections.find( serverName );
+        auto timeout = doc[ "Data" ].toInt( 60 );
+        if ( pos != fConnections.end() )
+            ( *pos ).second.fKeepAliveTimer->start( std::max( 1, timeout / 2 ) * 1000 );
+        sendMessage( serverName, "KeepAlive" );
+        return;
+    }
+
+    if ( messageType != "UserDataChanged" )
+        return;
+
+    for ( auto &&ii : parseMessage( serverName, message, receivedMSecs ) )
+        emit sigUserDataChanged( ii );
+}
+
+std::list< SUserDataChange > CUserDataListener::parseMessage( const QString &serverName, const QString &message, qint64 receivedMSecs )
+{
+    // { "MessageType": "UserDataChanged", "Data": { "UserId": "...", "UserDataList": [ { "ItemId": "...", "Played": true, ... } ] } }
+    auto doc = QJsonDocument::fromJson( message.toUtf8() );
+    if ( doc[ "MessageType" ].toString() != "UserDataChanged" )
+        return {};
+
+    auto data = doc[ "Data" ].toObject();
+    auto userID = data[ "UserId" ].toString();
+    if ( userID.isEmpty() )
+        return {};
+
+    std::list< SUserDataChange > retVal;
+    for ( auto &&ii : data[ "UserDataList" ].toArray() )
+    {
+        auto userData = ii.toObject();
+        auto mediaID = userData[ "ItemId" ].toString();
+        if ( mediaID.isEmpty() )
+            continue;
+
+        SUserDataChange change;
+        change.fServerName = serverName;
+        change.fUserID = userID;
+        change.fMediaID = mediaID;
+        change.fUserData = userData;
+        change.fReceivedMSecs = receivedMSecs;
+        retVal.push_back( change );
+    }
+    return retVal;
+}
+
+void CUserDataListener::sendMessage( const QString &serverName, const QString &messageType, const QJsonValue &data )
+{
+    auto pos = fConnections.find( serverName );
+    if ( ( pos == fConnections.end() ) || !( *pos ).second.fSocket->isValid() )
+        return;
+
+    QJsonObject message;
+    message[ "MessageType" ] = messageType;
+    if ( !data.isUndefined() && !data.isNull() )
+        message[ "Data" ] = data;
+    ( *pos ).second.fSocket->sendTextMessage( QString::fromUtf8( QJsonDocument( message ).toJson( QJsonDocument::Compact ) ) );
+}
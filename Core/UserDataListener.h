@@ -0,0 +1,109 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __USERDATALISTENER_H
+#define __USERDATALISTENER_H
+
+#include <QObject>
+#include <QJsonObject>
+#include <QString>
+#include <QUrl>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <tuple>
+
+class CServerModel;
+class QTimer;
+class QWebSocket;
+
+// one item of a UserDataChanged message, the user data is in the same layout as the UserData of an item
+struct SUserDataChange
+{
+    QString fServerName;
+    QString fUserID;
+    QString fMediaID;
+    QJsonObject fUserData;
+    qint64 fReceivedMSecs{ 0 };   // msecs since epoch when the message arrived
+};
+
+// The play state writes the sync made itself.  The servers report those back as UserDataChanged
+// events, which are dropped instead of being synced again.  An entry expires after the TTL so a
+// change the user makes to the same item later is still synced
+class CUserDataEchoFilter
+{
+public:
+    CUserDataEchoFilter( qint64 ttlMSecs = 60 * 1000 );
+
+    void addWrite( const QString &serverName, const QString &userID, const QString &mediaID, qint64 nowMSecs );
+    bool isEcho( const SUserDataChange &change );   // compared at the time the event arrived
+    size_t size() const { return fWrites.size(); }
+
+private:
+    void prune( qint64 nowMSecs );
+
+    qint64 fTTLMSecs{ 0 };
+    std::map< std::tuple< QString, QString, QString >, qint64 > fWrites;   // ( serverName, mediaID, userID ) -> msecs since epoch it expires
+};
+
+// Keeps a web socket open to each enabled server and reports the UserDataChanged
+// events they push.  A dropped connection is retried every reconnect interval.
+class CUserDataListener : public QObject
+{
+    Q_OBJECT
+public:
+    CUserDataListener( std::shared_ptr< CServerModel > serverModel, QObject *parent = nullptr );
+    ~CUserDataListener();
+
+    void start();   // connects to every enabled server
+    void addServer( const QString &serverName, const QUrl &url );   // the url of a stand-in server can be used directly
+    void stop();
+    void setReconnectMSecs( int msecs ) { fReconnectMSecs = msecs; }
+
+    static QUrl webSocketUrl( const QString &serverName, std::shared_ptr< CServerModel > serverModel );
+    static std::list< SUserDataChange > parseMessage( const QString &serverName, const QString &message, qint64 receivedMSecs );
+
+Q_SIGNALS:
+    void sigAddToLog( int msgType, const QString &msg );
+    void sigUserDataChanged( const SUserDataChange &change );
+
+private:
+    struct SConnection
+    {
+        QUrl fUrl;
+        QWebSocket *fSocket{ nullptr };
+        QTimer *fKeepAliveTimer{ nullptr };
+        QTimer *fReconnectTimer{ nullptr };
+    };
+
+    void open( const QString &serverName );
+    void handleMessage( const QString &serverName, const QString &message );
+    void sendMessage( const QString &serverName, const QString &messageType, const QJsonValue &data = {} );
+
+    std::shared_ptr< CServerModel > fServerModel;
+    std::map< QString, SConnection > fConnections;   // serverName -> socket
+    bool fStopping{ false };
+    int fReconnectMSecs;
+};
+
+#endif
@@ -26,18 +26,32 @@ set(FOLDER_NAME Libs)
 
 set(qtproject_SRCS
     CollectionsModel.cpp
+    DeltaSyncState.cpp
+    EmbyJSON.cpp
+    ItemsStreamReader.cpp
+    MediaCatalog.cpp
     MediaData.cpp
+    MediaID.cpp
+    MediaIndex.cpp
     MediaServerData.cpp
     MediaModel.cpp
     MovieSearchFilterModel.cpp
     MovieStub.cpp
     MergeMedia.cpp
     ProgressSystem.cpp
+    ProviderIDs.cpp
+    RequestContext.cpp
+    RequestScheduler.cpp
+    ResponseParser.cpp
+    SyncOperation.cpp
+    SyncPlan.cpp
     SyncSystem.cpp
     ServerInfo.cpp
     ServerModel.cpp
     Settings.cpp
+    Symbol.cpp
     UserData.cpp
+    UserDataListener.cpp
     UserServerData.cpp
     UsersModel.cpp
 )
@@ -46,19 +60,33 @@ set(qtproject_H
     CollectionsModel.h
     MediaModel.h
     MovieSearchFilterModel.h
+    ResponseParser.h
     ServerInfo.h
     SyncSystem.h
+    UserDataListener.h
     UsersModel.h
     ServerModel.h
 )
 
 set(project_H
+    DeltaSyncState.h
+    EmbyJSON.h
+    ItemsStreamReader.h
+    MediaCatalog.h
     MediaData.h
+    MediaID.h
+    MediaIndex.h
     MediaServerData.h
     MergeMedia.h
     MovieStub.h
     ProgressSystem.h
+    ProviderIDs.h
+    RequestContext.h
+    RequestScheduler.h
     Settings.h
+    Symbol.h
+    SyncOperation.h
+    SyncPlan.h
     UserData.h
     UserServerData.h
     IServerForColumn.h
@@ -73,4 +101,5 @@ set(qtproject_QRC
 )
 
 set( project_pub_DEPS
+    Qt5::WebSockets
 )
@@ -101,7 +101,7 @@ void CMediaDataWidget::load( std::shared_ptr< SMediaServerData > mediaData )
     {
         fImpl->isFavorite->setChecked( mediaData->fIsFavorite );
         fImpl->hasBeenPlayed->setChecked( mediaData->fPlayed );
-        fImpl->lastPlayedDate->setDateTime( mediaData->fLastPlayedDate );
+        fImpl->lastPlayedDate->setDateTime( mediaData->lastPlayedDate() );
         fImpl->playbackPosition->setTime( mediaData->playbackPositionTime() );
         fImpl->playCount->setValue( mediaData->fPlayCount );
     }
@@ -112,7 +112,7 @@ std::shared_ptr< SMediaServerData > CMediaDataWidget::createMediaUserData() cons
     auto retVal = std::make_shared< SMediaServerData >();
     retVal->fIsFavorite = fImpl->isFavorite->isChecked();
     retVal->fPlayed = fImpl->hasBeenPlayed->isChecked();
-    retVal->fLastPlayedDate = fImpl->lastPlayedDate->dateTime();
+    retVal->setLastPlayedDate( fImpl->lastPlayedDate->dateTime() );
     retVal->fPlayCount = fImpl->playCount->value();
     retVal->setPlaybackPosition( fImpl->playbackPosition->time() );
     return retVal;
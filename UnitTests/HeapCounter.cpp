@@ -0,0 +1,149 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "HeapCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined( _WIN32 )
+    #include <malloc.h>
+#elif defined( __APPLE__ )
+    #include <malloc/malloc.h>
+#else
+    #include <malloc.h>
+#endif
+
+namespace
+{
+    std::atomic< int64_t > sBytes{ 0 };
+    std::atomic< int64_t > sPeakBytes{ 0 };
+    std::atomic< int64_t > sAllocations{ 0 };
+
+    // the size of the block the C runtime handed out, so delete does not need a header in front of the memory.
+    // Memory new'd here and deleted by a Qt library ( or the reverse ) still goes to the same malloc and free
+    size_t blockSize( void *ptr )
+    {
+#if defined( _WIN32 )
+        return _msize( ptr );
+#elif defined( __APPLE__ )
+        return malloc_size( ptr );
+#else
+        return malloc_usable_size( ptr );
+#endif
+    }
+
+    void *allocate( size_t size ) noexcept
+    {
+        auto retVal = std::malloc( size ? size : 1 );
+        if ( !retVal )
+            return nullptr;
+
+        auto bytes = sBytes += static_cast< int64_t >( blockSize( retVal ) );
+        sAllocations++;
+        auto peak = sPeakBytes.load();
+        while ( ( bytes > peak ) && !sPeakBytes.compare_exchange_weak( peak, bytes ) )
+            ;
+        return retVal;
+    }
+
+    void deallocate( void *ptr ) noexcept
+    {
+        if ( !ptr )
+            return;
+        sBytes -= static_cast< int64_t >( blockSize( ptr ) );
+        std::free( ptr );
+    }
+}
+
+namespace NHeapCounter
+{
+    CScope::CScope() :
+        fStartBytes( sBytes ),
+        fStartAllocations( sAllocations )
+    {
+        sPeakBytes = fStartBytes;
+    }
+
+    SHeapUsage CScope::usage() const
+    {
+        SHeapUsage retVal;
+        retVal.fBytes = sBytes - fStartBytes;
+        retVal.fPeakBytes = sPeakBytes - fStartBytes;
+        retVal.fAllocations = sAllocations - fStartAllocations;
+        return retVal;
+    }
+}
+
+void *operator new( size_t size )
+{
+    auto retVal = allocate( size );
+    if ( !retVal )
+        throw std::bad_alloc();
+    return retVal;
+}
+
+void *operator new[]( size_t size )
+{
+    return operator new( size );
+}
+
+void *operator new( size_t size, const std::nothrow_t & ) noexcept
+{
+    return allocate( size );
+}
+
+void *operator new[]( size_t size, const std::nothrow_t & ) noexcept
+{
+    return allocate( size );
+}
+
+void operator delete( void *ptr ) noexcept
+{
+    deallocate( ptr );
+}
+
+void operator delete[]( void *ptr ) noexcept
+{
+    deallocate( ptr );
+}
+
+void operator delete( void *ptr, size_t ) noexcept
+{
+    deallocate( ptr );
+}
+
+void operator delete[]( void *ptr, size_t ) noexcept
+{
+    deallocate( ptr );
+}
+
+void operator delete( void *ptr, const std::nothrow_t & ) noexcept
+{
+    deallocate( ptr );
+}
+
+void operator delete[]( void *ptr, const std::nothrow_t & ) noexcept
+{
+    deallocate( ptr );
+}
@@ -0,0 +1,52 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __HEAPCOUNTER_H
+#define __HEAPCOUNTER_H
+
+#include <cstdint>
+
+// The test executable replaces the global operator new and delete to count the heap they use.
+// Only allocations made through operator new are seen, Qt's own buffers ( QString, QJsonObject )
+// are malloc'd and not included
+namespace NHeapCounter
+{
+    struct SHeapUsage
+    {
+        int64_t fBytes{ 0 };   // still allocated
+        int64_t fPeakBytes{ 0 };   // the most that was allocated at one time
+        int64_t fAllocations{ 0 };
+    };
+
+    // measures from its construction on, scopes can not be nested
+    class CScope
+    {
+    public:
+        CScope();
+        SHeapUsage usage() const;
+
+    private:
+        int64_t fStartBytes{ 0 };
+        int64_t fStartAllocations{ 0 };
+    };
+}
+#endif
@@ -0,0 +1,66 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "MediaDataBenchmark.h"
+#include "HeapCounter.h"
+#include "TestFixtures.h"
+
+#include "Core/MediaModel.h"
+
+#include <QTest>
+
+void CMediaDataBenchmark::heapPerItem()
+{
+    SMediaFixture fixture( 3 );
+
+    NHeapCounter::CScope scope;
+    fixture.loadMovies( 2000 );
+    fixture.merge();
+    auto usage = scope.usage();
+
+    QCOMPARE( fixture.fMediaModel->rowCount(), 2000 );
+    qInfo( "Loading and merging 2000 movies on 3 servers: %lld bytes and %lld allocations per movie still held", static_cast< long long >( usage.fBytes / 2000 ), static_cast< long long >( usage.fAllocations / 2000 ) );
+}
+
+void CMediaDataBenchmark::modelData()
+{
+    SMediaFixture fixture( 3 );
+    fixture.loadMovies( 2000 );
+    fixture.merge();
+
+    // what painting every cell asks the model for
+    auto &&model = *fixture.fMediaModel;
+    auto numRows = model.rowCount();
+    auto numColumns = model.columnCount();
+    QBENCHMARK
+    {
+        for ( int row = 0; row < numRows; ++row )
+        {
+            for ( int column = 0; column < numColumns; ++column )
+            {
+                auto index = model.index( row, column );
+                model.data( index, Qt::DisplayRole );
+                model.data( index, Qt::BackgroundRole );
+            }
+        }
+    }
+}
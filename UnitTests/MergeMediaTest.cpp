@@ -0,0 +1,264 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "MergeMediaTest.h"
+#include "TestFixtures.h"
+
+#include "Core/MediaData.h"
+#include "Core/MediaModel.h"
+#include "Core/ServerModel.h"
+
+#include <QTest>
+
+#include <memory>
+#include <set>
+
+using namespace NTestFixtures;
+
+namespace
+{
+    // the merge as it was before the provider key index, each server's provider search map is overwritten with
+    // the media of the other servers, and a media is replaced by the media its providers vote for on its own server
+    class CBaselineMerge
+    {
+    public:
+        struct SMedia
+        {
+            std::map< QString, QString > fProviders;
+        };
+        using TMediaIDToMediaData = std::map< QString, std::shared_ptr< SMedia > >;
+
+        void addMediaInfo( const QString &serverName, const QString &mediaID, const CMergeMediaTest::SItem &item )
+        {
+            auto mediaData = std::make_shared< SMedia >();
+            mediaData->fProviders = item.fProviders;
+            if ( mediaData->fProviders.empty() )
+                mediaData->fProviders[ "Movie" ] = item.fName;
+
+            fMediaMap[ serverName ][ mediaID ] = mediaData;
+            for ( auto &&ii : mediaData->fProviders )
+                fProviderSearchMap[ serverName ][ ii.first ][ ii.second ] = mediaData;
+        }
+
+        void merge()
+        {
+            for ( auto &&ii = fMediaMap.begin(); ii != fMediaMap.end(); ++ii )
+            {
+                for ( auto jj = ii; jj != fMediaMap.end(); ++jj )
+                {
+                    if ( ii == jj )
+                        continue;
+
+                    merge( *ii );
+                    merge( *jj );
+                    merge( *jj );
+                    merge( *ii );
+                }
+            }
+        }
+
+        QStringList groups() const
+        {
+            std::map< std::shared_ptr< SMedia >, QStringList > groups;
+            for ( auto &&ii : fMediaMap )
+            {
+                for ( auto &&jj : ii.second )
+                    groups[ jj.second ] << jj.first;
+            }
+
+            QStringList retVal;
+            for ( auto &&ii : groups )
+            {
+                ii.second.sort();
+                retVal << ii.second.join( "," );
+            }
+            retVal.sort();
+            return retVal;
+        }
+
+    private:
+        void merge( std::pair< const QString, TMediaIDToMediaData > &mapData )
+        {
+            std::map< std::shared_ptr< SMedia >, std::shared_ptr< SMedia > > replacementMap;
+            for ( auto &&ii : mapData.second )
+            {
+                auto mediaData = ii.second;
+                auto myMappedMedia = findMediaForProviders( mapData.first, mediaData->fProviders );
+                if ( myMappedMedia && ( myMappedMedia != mediaData ) )
+                {
+                    replacementMap[ mediaData ] = myMappedMedia;
+                    continue;
+                }
+
+                for ( auto &&jj : fProviderSearchMap )
+                {
+                    if ( jj.first == mapData.first )
+                        continue;
+
+                    if ( findMediaForProviders( jj.first, mediaData->fProviders ) == mediaData )
+                        continue;
+                    for ( auto &&kk : mediaData->fProviders )
+                        fProviderSearchMap[ jj.first ][ kk.first ][ kk.second ] = mediaData;
+                }
+            }
+            for ( auto &&ii : mapData.second )
+            {
+                auto pos = replacementMap.find( ii.second );
+                if ( pos != replacementMap.end() )
+                    ii.second = ( *pos ).second;
+            }
+        }
+
+        std::shared_ptr< SMedia > findMediaForProviders( const QString &serverName, const std::map< QString, QString > &providerIDs ) const
+        {
+            auto pos = fProviderSearchMap.find( serverName );
+            if ( pos == fProviderSearchMap.end() )
+                return {};
+
+            std::map< std::shared_ptr< SMedia >, int > mapCount;
+            for ( auto &&ii : providerIDs )
+            {
+                auto pos2 = ( *pos ).second.find( ii.first );
+                if ( pos2 == ( *pos ).second.end() )
+                    continue;
+                auto pos3 = ( *pos2 ).second.find( ii.second );
+                if ( pos3 == ( *pos2 ).second.end() )
+                    continue;
+                mapCount[ ( *pos3 ).second ]++;
+            }
+
+            int max = 0;
+            std::shared_ptr< SMedia > retVal;
+            for ( auto &&ii : mapCount )
+            {
+                if ( ii.second > max )
+                {
+                    max = ii.second;
+                    retVal = ii.first;
+                }
+            }
+            return retVal;
+        }
+
+        std::map< QString, TMediaIDToMediaData > fMediaMap;   // serverName -> mediaID -> media
+        std::map< QString, std::map< QString, std::map< QString, std::shared_ptr< SMedia > > > > fProviderSearchMap;   // serverName -> provider name -> provider ID -> media
+    };
+}
+
+// the fixtures never tie in the vote, the baseline broke ties by pointer order
+void CMergeMediaTest::initTestCase()
+{
+    for ( int ii = 0; ii < 3; ++ii )
+        fItems.push_back( { ii, "same", "Same", { { "Imdb", "tt1" }, { "Tmdb", "1" } } } );
+
+    // each server only has some of the ids
+    fItems.push_back( { 0, "partial", "Partial", { { "Imdb", "tt2" }, { "Tmdb", "2" } } } );
+    fItems.push_back( { 1, "partial", "Partial", { { "Imdb", "tt2" } } } );
+    fItems.push_back( { 2, "partial", "Partial", { { "Tmdb", "2" } } } );
+
+    // a box set id every title of the set has
+    for ( int ii = 0; ii < 2; ++ii )
+    {
+        fItems.push_back( { ii, "box1", "Box 1", { { "Imdb", "tt31" }, { "Tmdb", "31" }, { "TmdbCollection", "300" } } } );
+        fItems.push_back( { ii, "box2", "Box 2", { { "Imdb", "tt32" }, { "Tmdb", "32" }, { "TmdbCollection", "300" } } } );
+    }
+
+    // the same wrong id on two different titles of one server
+    fItems.push_back( { 0, "wrong1", "Wrong 1", { { "Imdb", "tt41" }, { "Tvdb", "41" } } } );
+    fItems.push_back( { 0, "wrong2", "Wrong 2", { { "Imdb", "tt42" }, { "Tvdb", "42" } } } );
+    fItems.push_back( { 1, "wrong1", "Wrong 1", { { "Imdb", "tt41" }, { "Tvdb", "41" }, { "Tmdb", "49" } } } );
+    fItems.push_back( { 1, "wrong2", "Wrong 2", { { "Imdb", "tt42" }, { "Tvdb", "42" }, { "Tmdb", "49" } } } );
+
+    fItems.push_back( { 2, "only", "Only", { { "Imdb", "tt5" } } } );
+
+    // no ids, matched by type and name
+    for ( int ii = 0; ii < 2; ++ii )
+        fItems.push_back( { ii, "noids", "No IDs", {} } );
+}
+
+void CMergeMediaTest::loadItems( SMediaFixture &fixture, int minServer, int maxServer ) const
+{
+    for ( auto &&item : fItems )
+    {
+        if ( ( item.fServerNum >= minServer ) && ( item.fServerNum <= maxServer ) )
+            fixture.fMediaModel->loadMedia( fixture.serverName( item.fServerNum ), movie( fixture.mediaID( item.fServerNum, item.fKey ), item.fName, 2000, item.fProviders ) );
+    }
+}
+
+QStringList CMergeMediaTest::mergedGroups( const SMediaFixture &fixture ) const
+{
+    QStringList retVal;
+    for ( auto &&mediaData : fixture.fMediaModel->getAllMedia() )
+    {
+        QStringList ids;
+        for ( int ii = 0; ii < fixture.fServerModel->serverCnt(); ++ii )
+        {
+            auto mediaID = mediaData->getMediaID( ii );
+            if ( !mediaID.isEmpty() )
+                ids << mediaID;
+        }
+        ids.sort();
+        retVal << ids.join( "," );
+    }
+    retVal.sort();
+    return retVal;
+}
+
+QStringList CMergeMediaTest::baselineGroups( const SMediaFixture &fixture ) const
+{
+    CBaselineMerge baseline;
+    for ( auto &&item : fItems )
+        baseline.addMediaInfo( fixture.serverName( item.fServerNum ), fixture.mediaID( item.fServerNum, item.fKey ), item );
+    baseline.merge();
+    return baseline.groups();
+}
+
+void CMergeMediaTest::mergeMatchesBaseline()
+{
+    SMediaFixture fixture( 3 );
+    loadItems( fixture, 0, 2 );
+    fixture.merge();
+
+    QCOMPARE( mergedGroups( fixture ), baselineGroups( fixture ) );
+}
+
+void CMergeMediaTest::incrementalMergeMatchesBaseline()
+{
+    SMediaFixture fixture( 3 );
+    loadItems( fixture, 0, 1 );
+    fixture.merge();
+    loadItems( fixture, 2, 2 );
+    fixture.merge();
+
+    QCOMPARE( mergedGroups( fixture ), baselineGroups( fixture ) );
+}
+
+void CMergeMediaTest::sharedIDDoesNotChain()
+{
+    SMediaFixture fixture( 3 );
+    loadItems( fixture, 0, 2 );
+    fixture.merge();
+
+    auto groups = mergedGroups( fixture );
+    QVERIFY( groups.contains( QString( "%1,%2" ).arg( fixture.mediaID( 0, "box1" ), fixture.mediaID( 1, "box1" ) ) ) );
+    QVERIFY( groups.contains( QString( "%1,%2" ).arg( fixture.mediaID( 0, "wrong1" ), fixture.mediaID( 1, "wrong1" ) ) ) );
+}
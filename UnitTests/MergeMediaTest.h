@@ -0,0 +1,62 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __MERGEMEDIATEST_H
+#define __MERGEMEDIATEST_H
+
+#include <QObject>
+#include <QStringList>
+
+#include <map>
+#include <vector>
+
+struct SMediaFixture;
+
+// The merge groups media by the per server provider id vote the merge has always made, the old
+// implementation is kept here as the reference
+class CMergeMediaTest : public QObject
+{
+    Q_OBJECT
+public:
+    struct SItem
+    {
+        int fServerNum{ 0 };
+        QString fKey;
+        QString fName;
+        std::map< QString, QString > fProviders;
+    };
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void mergeMatchesBaseline();
+    void incrementalMergeMatchesBaseline();
+    void sharedIDDoesNotChain();
+
+private:
+    void loadItems( SMediaFixture &fixture, int minServer, int maxServer ) const;
+    QStringList mergedGroups( const SMediaFixture &fixture ) const;
+    QStringList baselineGroups( const SMediaFixture &fixture ) const;
+
+    std::vector< SItem > fItems;
+};
+#endif
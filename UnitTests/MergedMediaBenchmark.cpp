@@ -0,0 +1,70 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "MergedMediaBenchmark.h"
+#include "HeapCounter.h"
+#include "TestFixtures.h"
+
+#include "Core/MediaModel.h"
+#include "Core/SyncPlan.h"
+
+#include <QTest>
+
+static constexpr int kNumServers = 3;
+static constexpr int kNumMovies = 5000;
+
+void CMergedMediaBenchmark::mergeMedia()
+{
+    SMediaFixture fixture( kNumServers );
+    fixture.loadMovies( kNumMovies );
+
+    // the merge and the model reset that takes the merged media
+    NHeapCounter::SHeapUsage usage;
+    QBENCHMARK_ONCE
+    {
+        NHeapCounter::CScope scope;
+        fixture.merge();
+        usage = scope.usage();
+    }
+    QCOMPARE( fixture.fMediaModel->rowCount(), kNumMovies );
+    qInfo( "Merging %d movies on %d servers: %lld KB peak heap, %lld allocations", kNumMovies, kNumServers, static_cast< long long >( usage.fPeakBytes / 1024 ), static_cast< long long >( usage.fAllocations ) );
+}
+
+void CMergedMediaBenchmark::buildSyncPlan()
+{
+    SMediaFixture fixture( kNumServers );
+    fixture.loadMovies( kNumMovies );
+    fixture.merge();
+
+    NHeapCounter::SHeapUsage usage;
+    {
+        NHeapCounter::CScope scope;
+        auto plan = fixture.syncPlan();
+        usage = scope.usage();
+    }
+    qInfo( "Building the sync plan for %d movies on %d servers: %lld KB peak heap, %lld allocations", kNumMovies, kNumServers, static_cast< long long >( usage.fPeakBytes / 1024 ), static_cast< long long >( usage.fAllocations ) );
+
+    QBENCHMARK
+    {
+        auto plan = fixture.syncPlan();
+    }
+}
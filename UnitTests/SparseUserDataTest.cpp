@@ -0,0 +1,176 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "SparseUserDataTest.h"
+#include "TestFixtures.h"
+
+#include "Core/MediaData.h"
+#include "Core/MediaModel.h"
+#include "Core/MediaServerData.h"
+#include "Core/SyncPlan.h"
+
+#include <QJsonDocument>
+#include <QTest>
+
+using namespace NTestFixtures;
+
+void CSparseUserDataTest::initTestCase()
+{
+    auto played = []( const QString &lastPlayed ) { return userData( true, false, 0, lastPlayed, 1 ); };
+    auto def = userData( false );
+
+    fItems = {
+        { "Alpha", { played( "2024-01-01T10:00:00.0000000Z" ), def, def } },
+        // unplayed on B after it was played on A, B's LastPlayedDate is the newest and only a fetch of B's default item has it
+        { "Bravo", { played( "2024-01-01T10:00:00.0000000Z" ), userData( false, false, 0, "2024-03-01T10:00:00.0000000Z", 1 ), def } },
+        { "Charlie", { def, userData( false, true ), def } },
+        { "Delta", { def, def, userData( false, false, 12345, "2024-02-01T10:00:00.0000000Z", 0 ) } },
+        { "Echo", { played( "2024-01-05T10:00:00.0000000Z" ), def, def }, { true, true, true }, { true, false, true } },
+        { "Foxtrot", { def, def, def } },
+        { "Golf", { played( "2024-01-10T10:00:00.0000000Z" ), played( "2024-01-10T10:00:00.0000000Z" ), played( "2024-01-10T10:00:00.0000000Z" ) } },
+        { "Hotel", { def, played( "2024-04-01T10:00:00.0000000Z" ), def }, { true, true, false } },
+        { "India", { userData( false, true ), def, def }, { true, true, true }, { true, true, false } },
+    };
+}
+
+void CSparseUserDataTest::loadCatalog( SMediaFixture &fixture ) const
+{
+    int year = 2000;
+    for ( auto &&item : fItems )
+    {
+        for ( int ii = 0; ii < kNumServers; ++ii )
+        {
+            if ( item.fOnServer[ ii ] )
+                fixture.fMediaModel->loadMedia( fixture.serverName( ii ), movie( fixture.mediaID( ii, item.fName ), item.fName, year, { { "Imdb", QString( "tt%1" ).arg( year ) } } ) );
+        }
+        year++;
+    }
+    fixture.merge();
+}
+
+void CSparseUserDataTest::loadFull( SMediaFixture &fixture ) const
+{
+    for ( int ii = 0; ii < kNumServers; ++ii )
+    {
+        auto serverName = fixture.serverName( ii );
+        fixture.fMediaModel->beginUserDataLoad( serverName );
+        for ( auto &&item : fItems )
+        {
+            if ( item.fOnServer[ ii ] && item.fVisible[ ii ] )
+                QVERIFY( fixture.fMediaModel->loadUserData( serverName, userDataItem( fixture.mediaID( ii, item.fName ), item.fUserData[ ii ] ) ) );
+        }
+        fixture.fMediaModel->endUserDataLoad( serverName, true );
+    }
+}
+
+// the same steps as CSyncSystem, the filtered lists from every server, then the gaps by ID
+void CSparseUserDataTest::loadSparse( SMediaFixture &fixture ) const
+{
+    for ( int ii = 0; ii < kNumServers; ++ii )
+        fixture.fMediaModel->beginUserDataLoad( fixture.serverName( ii ) );
+
+    for ( int ii = 0; ii < kNumServers; ++ii )
+    {
+        auto serverName = fixture.serverName( ii );
+        for ( auto &&item : fItems )
+        {
+            if ( item.fOnServer[ ii ] && item.fVisible[ ii ] && !isDefault( item.fUserData[ ii ] ) )
+                QVERIFY( fixture.fMediaModel->loadUserData( serverName, userDataItem( fixture.mediaID( ii, item.fName ), item.fUserData[ ii ] ) ) );
+        }
+    }
+
+    auto gaps = fixture.fMediaModel->sparseUserDataGaps();
+    for ( int ii = 0; ii < kNumServers; ++ii )
+    {
+        auto serverName = fixture.serverName( ii );
+        for ( auto &&mediaID : gaps[ serverName ] )
+        {
+            auto item = findItem( fixture, ii, mediaID );
+            QVERIFY( item );
+            if ( item->fVisible[ ii ] )
+                QVERIFY( fixture.fMediaModel->loadUserData( serverName, userDataItem( mediaID, item->fUserData[ ii ] ) ) );
+        }
+    }
+
+    for ( int ii = 0; ii < kNumServers; ++ii )
+        fixture.fMediaModel->endUserDataLoad( fixture.serverName( ii ), false );
+}
+
+const CSparseUserDataTest::SItem *CSparseUserDataTest::findItem( const SMediaFixture &fixture, int serverNum, const QString &mediaID ) const
+{
+    for ( auto &&item : fItems )
+    {
+        if ( fixture.mediaID( serverNum, item.fName ) == mediaID )
+            return &item;
+    }
+    return nullptr;
+}
+
+void CSparseUserDataTest::sparseMatchesFull()
+{
+    SMediaFixture full( kNumServers );
+    loadCatalog( full );
+    loadFull( full );
+
+    SMediaFixture sparse( kNumServers );
+    loadCatalog( sparse );
+    loadSparse( sparse );
+
+    auto fullPlan = full.syncPlan();
+    QVERIFY( !fullPlan.empty() );
+    QCOMPARE( QJsonDocument( sparse.syncPlan().toJson() ).toJson(), QJsonDocument( fullPlan.toJson() ).toJson() );
+}
+
+void CSparseUserDataTest::sparseKeepsUnplay()
+{
+    SMediaFixture sparse( kNumServers );
+    loadCatalog( sparse );
+    loadSparse( sparse );
+
+    auto plan = sparse.syncPlan();
+    bool found = false;
+    for ( auto &&mutation : plan.mutations() )
+    {
+        if ( ( mutation.fServerName != sparse.serverName( 0 ) ) || ( mutation.fMediaData->name() != "Bravo" ) )
+            continue;
+        found = true;
+        QVERIFY( mutation.fUpdateUserData );
+        QVERIFY( !mutation.fNewData->fPlayed );
+    }
+    QVERIFY( found );
+}
+
+void CSparseUserDataTest::sparseHidesUnreturnedGaps()
+{
+    SMediaFixture sparse( kNumServers );
+    loadCatalog( sparse );
+    loadSparse( sparse );
+
+    // both were returned by another server, asked for by ID and not returned, the user can not see them
+    auto echo = sparse.fMediaModel->getMediaDataForID( sparse.serverName( 1 ), sparse.mediaID( 1, "Echo" ) );
+    QVERIFY( echo );
+    QVERIFY( !echo->isValidForServer( sparse.serverName( 1 ) ) );
+
+    auto india = sparse.fMediaModel->getMediaDataForID( sparse.serverName( 2 ), sparse.mediaID( 2, "India" ) );
+    QVERIFY( india );
+    QVERIFY( !india->isValidForServer( sparse.serverName( 2 ) ) );
+}
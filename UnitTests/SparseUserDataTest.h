@@ -0,0 +1,63 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __SPARSEUSERDATATEST_H
+#define __SPARSEUSERDATATEST_H
+
+#include <QObject>
+#include <QJsonObject>
+
+#include <array>
+#include <vector>
+
+struct SMediaFixture;
+
+// A sparse play state load ( SparseUserData ) has to give the same sync plan as loading every item
+class CSparseUserDataTest : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int kNumServers = 3;
+    struct SItem
+    {
+        QString fName;
+        std::array< QJsonObject, kNumServers > fUserData;
+        std::array< bool, kNumServers > fOnServer{ true, true, true };   // in the catalog
+        std::array< bool, kNumServers > fVisible{ true, true, true };   // returned for the user
+    };
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void sparseMatchesFull();
+    void sparseKeepsUnplay();
+    void sparseHidesUnreturnedGaps();
+
+private:
+    void loadCatalog( SMediaFixture &fixture ) const;
+    void loadFull( SMediaFixture &fixture ) const;
+    void loadSparse( SMediaFixture &fixture ) const;
+    const SItem *findItem( const SMediaFixture &fixture, int serverNum, const QString &mediaID ) const;
+
+    std::vector< SItem > fItems;
+};
+#endif
@@ -0,0 +1,100 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "SymbolBenchmark.h"
+#include "HeapCounter.h"
+#include "TestFixtures.h"
+
+#include "Core/MediaData.h"
+#include "Core/MediaModel.h"
+
+#include <QTest>
+
+#include <unordered_set>
+
+static constexpr int kNumEpisodes = 200000;
+static constexpr int kEpisodesPerSeries = 100;
+
+namespace
+{
+    // QString buffers are malloc'd by Qt, so they are not seen by the heap counter and are added up here.
+    // A buffer shared by several strings is counted once
+    int64_t stringBytes( const QString &str, std::unordered_set< const void * > &counted )
+    {
+        if ( str.isNull() || !counted.insert( str.constData() ).second )
+            return 0;
+        return static_cast< int64_t >( sizeof( QStringData ) + ( str.capacity() + 1 ) * sizeof( QChar ) );
+    }
+}
+
+CSymbolBenchmark::CSymbolBenchmark()
+{
+}
+
+CSymbolBenchmark::~CSymbolBenchmark()
+{
+}
+
+void CSymbolBenchmark::initTestCase()
+{
+    // loading the library once is most of the run time, both benchmarks share it
+    fFixture = std::make_unique< SMediaFixture >( 1 );
+
+    NHeapCounter::CScope scope;
+    auto serverName = fFixture->serverName( 0 );
+    for ( int ii = 0; ii < kNumEpisodes; ++ii )
+    {
+        auto episodeNum = ii % kEpisodesPerSeries;
+        auto seriesName = QString( "Benchmark Series %1" ).arg( ii / kEpisodesPerSeries );
+        fFixture->fMediaModel->loadMedia( serverName, NTestFixtures::episode( fFixture->mediaID( 0, QString::number( ii ) ), seriesName, 1 + episodeNum / 10, 1 + episodeNum % 10 ) );
+    }
+    fFixture->merge();
+    fLoadBytes = scope.usage().fBytes;
+
+    QCOMPARE( fFixture->fMediaModel->getAllMedia().size(), size_t( kNumEpisodes ) );
+}
+
+void CSymbolBenchmark::cleanupTestCase()
+{
+    fFixture.reset();
+}
+
+void CSymbolBenchmark::heapPerEpisode()
+{
+    // the item type and series name buffers the items hold, interned they are one buffer per show
+    int64_t stringBytes = 0;
+    std::unordered_set< const void * > counted;
+    for ( auto &&ii : fFixture->fMediaModel->getAllMedia() )
+        stringBytes += ::stringBytes( ii->mediaType(), counted ) + ::stringBytes( ii->seriesName(), counted );
+
+    qInfo( "Loading and merging %d episodes: %lld bytes per episode on the heap, the type and series names add %lld KB", kNumEpisodes, static_cast< long long >( fLoadBytes / kNumEpisodes ), static_cast< long long >( stringBytes / 1024 ) );
+}
+
+void CSymbolBenchmark::knownShows()
+{
+    size_t numShows = 0;
+    QBENCHMARK
+    {
+        numShows = fFixture->fMediaModel->getKnownShows().size();
+    }
+    QCOMPARE( numShows, size_t( kNumEpisodes / kEpisodesPerSeries ) );
+}
@@ -0,0 +1,53 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __SYMBOLBENCHMARK_H
+#define __SYMBOLBENCHMARK_H
+
+#include <QObject>
+
+#include <cstdint>
+#include <memory>
+
+struct SMediaFixture;
+
+// A 200k episode library loaded through the media model, the heap it holds and CMediaModel::getKnownShows.
+// Run on a checkout from before the item type and series name were interned for the numbers to compare against
+class CSymbolBenchmark : public QObject
+{
+    Q_OBJECT
+public:
+    CSymbolBenchmark();
+    ~CSymbolBenchmark();
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void heapPerEpisode();
+    void knownShows();
+
+private:
+    std::unique_ptr< SMediaFixture > fFixture;
+    int64_t fLoadBytes{ 0 };
+};
+#endif
@@ -0,0 +1,156 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "TestFixtures.h"
+
+#include "Core/CollectionsModel.h"
+#include "Core/MediaModel.h"
+#include "Core/MediaData.h"
+#include "Core/ProgressSystem.h"
+#include "Core/ServerInfo.h"
+#include "Core/ServerModel.h"
+#include "Core/Settings.h"
+#include "Core/SyncPlan.h"
+#include "Core/SyncSystem.h"
+#include "Core/UserData.h"
+#include "Core/UsersModel.h"
+
+#include <vector>
+
+SMediaFixture::SMediaFixture( int numServers, const QStringList &serverUrls )
+{
+    fServerModel = std::make_shared< CServerModel >();
+    std::vector< std::shared_ptr< CServerInfo > > servers;
+    for ( int ii = 0; ii < numServers; ++ii )
+    {
+        auto name = QString( "Server%1" ).arg( QChar( 'A' + ii ) );
+        auto url = ( ii < serverUrls.size() ) ? serverUrls[ ii ] : QString( "http://%1.test:8096" ).arg( name.toLower() );
+        servers.push_back( std::make_shared< CServerInfo >( name, url, "apikey", true ) );
+    }
+    fServerModel->setServers( servers );
+
+    fSettings = std::make_shared< CSettings >( false, fServerModel );
+    fMediaModel = std::make_shared< CMediaModel >( fSettings, fServerModel );
+
+    // through the users model, so the user of an event can be found by its id on a server
+    fUsersModel = std::make_shared< CUsersModel >( fSettings, fServerModel );
+    for ( int ii = 0; ii < numServers; ++ii )
+        fUser = fUsersModel->loadUser( serverName( ii ), QJsonObject( { { "Name", "user" }, { "Id", QString( "user-%1" ).arg( ii ) } } ) );
+
+    fCollectionsModel = std::make_shared< CCollectionsModel >( fMediaModel );
+    fSyncSystem = std::make_shared< CSyncSystem >( fSettings, fUsersModel, fMediaModel, fCollectionsModel, fServerModel );
+    fSyncSystem->setCurrentUser( ETool::ePlayState, fUser, false );
+}
+
+QString SMediaFixture::serverName( int serverNum ) const
+{
+    return fServerModel->getServerInfo( serverNum )->keyName();
+}
+
+QString SMediaFixture::mediaID( int serverNum, const QString &key ) const
+{
+    return QString( "%1-%2" ).arg( serverNum ).arg( key );
+}
+
+void SMediaFixture::loadMovies( int numMovies )
+{
+    auto numServers = fServerModel->serverCnt();
+    for ( int ii = 0; ii < numMovies; ++ii )
+    {
+        auto name = QString( "Movie %1" ).arg( ii );
+        for ( int jj = 0; jj < numServers; ++jj )
+        {
+            auto played = ( ii % 3 ) != 0;
+            if ( ( ( ii % 3 ) == 1 ) && ( jj == ( ii % numServers ) ) )
+                played = !played;
+
+            auto media = NTestFixtures::movie( mediaID( jj, name ), name, 1950 + ( ii % 70 ), { { "Imdb", QString( "tt%1" ).arg( ii ) } } );
+            media[ "UserData" ] = NTestFixtures::userData( played, ( ii % 7 ) == 0, ( ii % 5 ) * 10000000LL, played ? "2024-01-01T10:00:00.0000000Z" : QString(), played ? 1 : 0 );
+            fMediaModel->loadMedia( serverName( jj ), media );
+        }
+    }
+}
+
+void SMediaFixture::merge()
+{
+    fMediaModel->mergeMedia( std::make_shared< CProgressSystem >() );
+}
+
+CSyncPlan SMediaFixture::syncPlan() const
+{
+    return fSyncSystem->buildSyncPlan( {} );
+}
+
+namespace NTestFixtures
+{
+    QJsonObject movie( const QString &id, const QString &name, int year, const std::map< QString, QString > &providerIDs )
+    {
+        QJsonObject providerIDsObj;
+        for ( auto &&ii : providerIDs )
+            providerIDsObj[ ii.first ] = ii.second;
+
+        QJsonObject retVal;
+        retVal[ "Id" ] = id;
+        retVal[ "Name" ] = name;
+        retVal[ "Type" ] = "Movie";
+        retVal[ "ProductionYear" ] = year;
+        retVal[ "ProviderIds" ] = providerIDsObj;
+        return retVal;
+    }
+
+    QJsonObject episode( const QString &id, const QString &seriesName, int season, int episodeNum )
+    {
+        QJsonObject retVal;
+        retVal[ "Id" ] = id;
+        retVal[ "Name" ] = QString( "Episode %1" ).arg( episodeNum );
+        retVal[ "Type" ] = "Episode";
+        retVal[ "SeriesName" ] = seriesName;
+        retVal[ "SeasonName" ] = QString( "Season %1" ).arg( season );
+        retVal[ "IndexNumber" ] = episodeNum;
+        return retVal;
+    }
+
+    QJsonObject userData( bool played, bool favorite, qint64 positionTicks, const QString &lastPlayed, int playCount )
+    {
+        QJsonObject retVal;
+        retVal[ "Played" ] = played;
+        retVal[ "IsFavorite" ] = favorite;
+        retVal[ "PlaybackPositionTicks" ] = positionTicks;
+        retVal[ "PlayCount" ] = playCount;
+        if ( !lastPlayed.isEmpty() )
+            retVal[ "LastPlayedDate" ] = lastPlayed;
+        return retVal;
+    }
+
+    QJsonObject userDataItem( const QString &id, const QJsonObject &userData )
+    {
+        QJsonObject retVal;
+        retVal[ "Id" ] = id;
+        retVal[ "UserData" ] = userData;
+        return retVal;
+    }
+
+    bool isDefault( const QJsonObject &userData )
+    {
+        return !userData[ "Played" ].toBool() && !userData[ "IsFavorite" ].toBool() && ( userData[ "PlaybackPositionTicks" ].toVariant().toLongLong() <= 0 );
+    }
+}
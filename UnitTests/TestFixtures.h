@@ -0,0 +1,72 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __TESTFIXTURES_H
+#define __TESTFIXTURES_H
+
+#include <QString>
+#include <QStringList>
+#include <QJsonObject>
+
+#include <map>
+#include <memory>
+
+class CServerModel;
+class CSettings;
+class CMediaModel;
+class CUsersModel;
+class CCollectionsModel;
+class CSyncSystem;
+class CUserData;
+class CSyncPlan;
+
+// servers, settings, a media model, a sync system and one user, all in memory.  No requests are answered
+// unless the urls of stand-in servers are given
+struct SMediaFixture
+{
+    SMediaFixture( int numServers, const QStringList &serverUrls = {} );
+
+    QString serverName( int serverNum ) const;
+    QString mediaID( int serverNum, const QString &key ) const;   // unique per server, so the same key is a different ID on each
+
+    void loadMovies( int numMovies );   // on every server, one in three has a different play state on one server
+    void merge();
+    CSyncPlan syncPlan() const;   // CSyncSystem::buildSyncPlan for the user
+
+    std::shared_ptr< CServerModel > fServerModel;
+    std::shared_ptr< CSettings > fSettings;
+    std::shared_ptr< CMediaModel > fMediaModel;
+    std::shared_ptr< CUsersModel > fUsersModel;
+    std::shared_ptr< CCollectionsModel > fCollectionsModel;
+    std::shared_ptr< CSyncSystem > fSyncSystem;
+    std::shared_ptr< CUserData > fUser;
+};
+
+namespace NTestFixtures
+{
+    QJsonObject movie( const QString &id, const QString &name, int year, const std::map< QString, QString > &providerIDs );
+    QJsonObject episode( const QString &id, const QString &seriesName, int season, int episodeNum );
+    QJsonObject userData( bool played, bool favorite = false, qint64 positionTicks = 0, const QString &lastPlayed = {}, int playCount = 0 );
+    QJsonObject userDataItem( const QString &id, const QJsonObject &userData );   // what a Users/<>/Items list returns for an item
+    bool isDefault( const QJsonObject &userData );   // would not be returned by the sparse filters
+}
+#endif
@@ -0,0 +1,274 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "UserDataListenerTest.h"
+#include "TestFixtures.h"
+
+#include "Core/MediaModel.h"
+#include "Core/SyncSystem.h"
+#include "Core/UserDataListener.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTest>
+#include <QWebSocket>
+#include <QWebSocketServer>
+
+#include <list>
+#include <memory>
+#include <utility>
+
+namespace
+{
+    QString userDataChanged( const QString &userID, const QStringList &mediaIDs )
+    {
+        QJsonArray userDataList;
+        for ( auto &&ii : mediaIDs )
+        {
+            QJsonObject userData;
+            userData[ "ItemId" ] = ii;
+            userData[ "Played" ] = true;
+            userData[ "PlayCount" ] = 1;
+            userDataList.push_back( userData );
+        }
+
+        QJsonObject data;
+        data[ "UserId" ] = userID;
+        data[ "UserDataList" ] = userDataList;
+
+        QJsonObject message;
+        message[ "MessageType" ] = "UserDataChanged";
+        message[ "Data" ] = data;
+        return QString::fromUtf8( QJsonDocument( message ).toJson( QJsonDocument::Compact ) );
+    }
+
+    // accepts the listener's connections and keeps every message it sends
+    struct SStandInServer
+    {
+        SStandInServer() :
+            fServer( "EmbyStandIn", QWebSocketServer::NonSecureMode )
+        {
+            QObject::connect(
+                &fServer, &QWebSocketServer::newConnection,
+                [ this ]()
+                {
+                    auto socket = fServer.nextPendingConnection();
+                    QObject::connect( socket, &QWebSocket::textMessageReceived, [ this ]( const QString &message ) { fReceived.push_back( QJsonDocument::fromJson( message.toUtf8() )[ "MessageType" ].toString() ); } );
+                    fSockets.push_back( socket );
+                } );
+            fServer.listen( QHostAddress::LocalHost );
+        }
+
+        QUrl url() const { return QUrl( QString( "ws://127.0.0.1:%1/embywebsocket" ).arg( fServer.serverPort() ) ); }
+
+        QWebSocketServer fServer;
+        std::list< QWebSocket * > fSockets;   // owned by the server
+        QStringList fReceived;
+    };
+
+    // answers the sync system's HTTP requests to one server, a GET with the set reply and anything else with an empty object
+    struct SStandInHttpServer
+    {
+        SStandInHttpServer()
+        {
+            QObject::connect(
+                &fServer, &QTcpServer::newConnection,
+                [ this ]()
+                {
+                    auto socket = fServer.nextPendingConnection();
+                    auto buffer = std::make_shared< QByteArray >();
+                    QObject::connect( socket, &QTcpSocket::readyRead, [ this, socket, buffer ]() { handleRequest( socket, *buffer ); } );
+                    QObject::connect( socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater );
+                } );
+            fServer.listen( QHostAddress::LocalHost );
+        }
+
+        QString url() const { return QString( "http://127.0.0.1:%1" ).arg( fServer.serverPort() ); }
+        bool received( const QString &method, const QString &pathEnd ) const
+        {
+            for ( auto &&ii : fRequests )
+            {
+                if ( ( ii.first == method ) && ii.second.endsWith( pathEnd ) )
+                    return true;
+            }
+            return false;
+        }
+
+        void handleRequest( QTcpSocket *socket, QByteArray &buffer )
+        {
+            buffer += socket->readAll();
+            auto headerEnd = buffer.indexOf( "\r\n\r\n" );
+            if ( headerEnd < 0 )
+                return;
+
+            auto headers = QString::fromLatin1( buffer.left( headerEnd ) ).split( "\r\n" );
+            int contentLength = 0;
+            for ( auto &&ii : headers )
+            {
+                if ( ii.startsWith( "Content-Length:", Qt::CaseInsensitive ) )
+                    contentLength = ii.mid( ii.indexOf( ':' ) + 1 ).trimmed().toInt();
+            }
+            if ( buffer.size() < ( headerEnd + 4 + contentLength ) )
+                return;
+
+            auto requestLine = headers.front().split( ' ' );
+            auto method = requestLine.value( 0 );
+            fRequests.emplace_back( method, QUrl( requestLine.value( 1 ) ).path() );
+            buffer.clear();
+
+            auto body = ( method == "GET" ) ? fGetReply : QByteArray( "{}" );
+            socket->write( "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " + QByteArray::number( body.size() ) + "\r\nConnection: close\r\n\r\n" + body );
+            socket->disconnectFromHost();
+        }
+
+        QTcpServer fServer;
+        QByteArray fGetReply;
+        std::list< std::pair< QString, QString > > fRequests;   // method, path
+    };
+}
+
+void CUserDataListenerTest::parseMessage()
+{
+    auto message = userDataChanged( "user-1", { "A-1", QString(), "A-2" } );
+    auto changes = CUserDataListener::parseMessage( "ServerA", message, 1000 );
+    QCOMPARE( changes.size(), size_t( 2 ) );   // the item without an ItemId is skipped
+    QCOMPARE( changes.front().fServerName, QString( "ServerA" ) );
+    QCOMPARE( changes.front().fUserID, QString( "user-1" ) );
+    QCOMPARE( changes.front().fMediaID, QString( "A-1" ) );
+    QCOMPARE( changes.front().fUserData[ "Played" ].toBool(), true );
+    QCOMPARE( changes.front().fReceivedMSecs, qint64( 1000 ) );
+    QCOMPARE( changes.back().fMediaID, QString( "A-2" ) );
+
+    QVERIFY( CUserDataListener::parseMessage( "ServerA", userDataChanged( QString(), { "A-1" } ), 0 ).empty() );
+    QVERIFY( CUserDataListener::parseMessage( "ServerA", R"({"MessageType":"ForceKeepAlive","Data":60})", 0 ).empty() );
+    QVERIFY( CUserDataListener::parseMessage( "ServerA", "not json", 0 ).empty() );
+}
+
+void CUserDataListenerTest::receivesEvents()
+{
+    SStandInServer server;
+    QVERIFY( server.fServer.isListening() );
+
+    std::list< SUserDataChange > changes;
+    CUserDataListener listener( {} );
+    connect( &listener, &CUserDataListener::sigUserDataChanged, [ &changes ]( const SUserDataChange &change ) { changes.push_back( change ); } );
+    listener.addServer( "ServerA", server.url() );
+    QTRY_COMPARE( server.fSockets.size(), size_t( 1 ) );
+
+    // a ForceKeepAlive is answered right away
+    server.fSockets.back()->sendTextMessage( R"({"MessageType":"ForceKeepAlive","Data":60})" );
+    QTRY_COMPARE( server.fReceived, QStringList() << "KeepAlive" );
+
+    server.fSockets.back()->sendTextMessage( R"({"MessageType":"LibraryChanged","Data":{}})" );
+    server.fSockets.back()->sendTextMessage( userDataChanged( "user-1", { "A-1", "A-2" } ) );
+    QTRY_COMPARE( changes.size(), size_t( 2 ) );
+    QCOMPARE( changes.front().fServerName, QString( "ServerA" ) );
+    QCOMPARE( changes.front().fMediaID, QString( "A-1" ) );
+    QVERIFY( changes.front().fReceivedMSecs > 0 );
+    QCOMPARE( changes.back().fMediaID, QString( "A-2" ) );
+}
+
+void CUserDataListenerTest::reconnects()
+{
+    SStandInServer server;
+    QVERIFY( server.fServer.isListening() );
+
+    std::list< SUserDataChange > changes;
+    CUserDataListener listener( {} );
+    listener.setReconnectMSecs( 100 );
+    connect( &listener, &CUserDataListener::sigUserDataChanged, [ &changes ]( const SUserDataChange &change ) { changes.push_back( change ); } );
+    listener.addServer( "ServerA", server.url() );
+    QTRY_COMPARE( server.fSockets.size(), size_t( 1 ) );
+
+    // the server drops the session, the listener opens a new one and keeps reporting
+    server.fSockets.back()->close();
+    QTRY_COMPARE( server.fSockets.size(), size_t( 2 ) );
+    QTRY_COMPARE( server.fSockets.back()->state(), QAbstractSocket::ConnectedState );
+
+    server.fSockets.back()->sendTextMessage( userDataChanged( "user-1", { "A-3" } ) );
+    QTRY_COMPARE( changes.size(), size_t( 1 ) );
+    QCOMPARE( changes.front().fMediaID, QString( "A-3" ) );
+
+    // once stopped a dropped connection is not retried
+    listener.stop();
+    QTest::qWait( 300 );
+    QCOMPARE( server.fSockets.size(), size_t( 2 ) );
+}
+
+void CUserDataListenerTest::dropsEchoes()
+{
+    CUserDataEchoFilter filter( 1000 );
+    filter.addWrite( "ServerB", "user-1", "B-1", 10000 );
+
+    auto change = CUserDataListener::parseMessage( "ServerB", userDataChanged( "user-1", { "B-1" } ), 10500 ).front();
+    QVERIFY( filter.isEcho( change ) );
+    QVERIFY( filter.isEcho( change ) );   // the favorite write comes back as a second event
+
+    auto otherUser = CUserDataListener::parseMessage( "ServerB", userDataChanged( "user-2", { "B-1" } ), 10500 ).front();
+    QVERIFY( !filter.isEcho( otherUser ) );
+    auto otherServer = CUserDataListener::parseMessage( "ServerA", userDataChanged( "user-1", { "B-1" } ), 10500 ).front();
+    QVERIFY( !filter.isEcho( otherServer ) );
+
+    // a change made by the user after the TTL is synced
+    change.fReceivedMSecs = 11000;
+    QVERIFY( !filter.isEcho( change ) );
+    QCOMPARE( filter.size(), size_t( 0 ) );
+}
+
+void CUserDataListenerTest::syncsChangeToOtherServers()
+{
+    SStandInHttpServer httpServerA;
+    SStandInHttpServer httpServerB;
+    QVERIFY( httpServerA.fServer.isListening() && httpServerB.fServer.isListening() );
+
+    // the movie is unplayed on both servers
+    SMediaFixture fixture( 2, { httpServerA.url(), httpServerB.url() } );
+    auto mediaIDB = fixture.mediaID( 1, "Movie" );
+    for ( int ii = 0; ii < 2; ++ii )
+    {
+        auto media = NTestFixtures::movie( fixture.mediaID( ii, "Movie" ), "Movie", 2000, { { "Imdb", "tt1" } } );
+        media[ "UserData" ] = NTestFixtures::userData( false );
+        fixture.fMediaModel->loadMedia( fixture.serverName( ii ), media );
+    }
+    fixture.merge();
+
+    // server B is reloaded for the user of the event before it is compared, it still has the movie unplayed
+    auto reloaded = NTestFixtures::movie( mediaIDB, "Movie", 2000, { { "Imdb", "tt1" } } );
+    reloaded[ "UserData" ] = NTestFixtures::userData( false );
+    httpServerB.fGetReply = QJsonDocument( QJsonObject( { { "Items", QJsonArray( { reloaded } ) } } ) ).toJson( QJsonDocument::Compact );
+
+    SStandInServer webSocketServer;
+    QVERIFY( webSocketServer.fServer.isListening() );
+    CUserDataListener listener( {} );
+    connect( &listener, &CUserDataListener::sigUserDataChanged, fixture.fSyncSystem.get(), &CSyncSystem::syncUserDataChange );
+    listener.addServer( fixture.serverName( 0 ), webSocketServer.url() );
+    QTRY_COMPARE( webSocketServer.fSockets.size(), size_t( 1 ) );
+
+    // played on server A, the play state is written to server B only
+    webSocketServer.fSockets.back()->sendTextMessage( userDataChanged( "user-0", { fixture.mediaID( 0, "Movie" ) } ) );
+    QTRY_VERIFY( httpServerB.received( "POST", QString( "Users/user-1/Items/%1/UserData" ).arg( mediaIDB ) ) );
+    QCOMPARE( httpServerB.fRequests.front().first, QString( "GET" ) );
+    QVERIFY( httpServerB.fRequests.front().second.endsWith( "Users/user-1/Items" ) );
+    QVERIFY( httpServerA.fRequests.empty() );
+}
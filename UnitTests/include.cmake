@@ -0,0 +1,68 @@
+# The MIT License (MIT)
+#
+# Copyright (c) 2022 Scott Aron Bloom
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+set(_PROJECT_NAME EmbySyncUnitTests)
+set(USE_QT TRUE)
+set(FOLDER_NAME UnitTests)
+
+set(qtproject_SRCS
+    main.cpp
+)
+
+set(project_SRCS
+    HeapCounter.cpp
+    TestFixtures.cpp
+    MediaDataBenchmark.cpp
+    MergedMediaBenchmark.cpp
+    MergeMediaTest.cpp
+    SparseUserDataTest.cpp
+    SymbolBenchmark.cpp
+    UserDataListenerTest.cpp
+)
+
+set(qtproject_H
+    MediaDataBenchmark.h
+    MergedMediaBenchmark.h
+    MergeMediaTest.h
+    SparseUserDataTest.h
+    SymbolBenchmark.h
+    UserDataListenerTest.h
+)
+
+set(project_H
+    HeapCounter.h
+    TestFixtures.h
+)
+
+set(qtproject_UIS
+)
+
+
+set(qtproject_QRC
+)
+
+set( project_pub_DEPS
+        SABUtils
+        Core
+        Qt5::Test
+        Qt5::WebSockets
+)
@@ -0,0 +1,84 @@
+// The MIT License( MIT )
+//
+// Copyright( c ) 2022 Scott Aron Bloom
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sub-license, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "MediaDataBenchmark.h"
+#include "MergedMediaBenchmark.h"
+#include "MergeMediaTest.h"
+#include "SparseUserDataTest.h"
+#include "SymbolBenchmark.h"
+#include "UserDataListenerTest.h"
+
+#include <QCoreApplication>
+#include <QTest>
+
+#include <cstring>
+#include <vector>
+
+int main( int argc, char **argv )
+{
+    QCoreApplication appl( argc, argv );
+
+    // the benchmarks load large libraries, they only run when "-benchmarks" is given and the rest of the arguments go to QTest
+    bool benchmarks = false;
+    std::vector< char * > args;
+    for ( int ii = 0; ii < argc; ++ii )
+    {
+        if ( std::strcmp( argv[ ii ], "-benchmarks" ) == 0 )
+            benchmarks = true;
+        else
+            args.push_back( argv[ ii ] );
+    }
+    argc = static_cast< int >( args.size() );
+    argv = args.data();
+
+    int retVal = 0;
+    if ( benchmarks )
+    {
+        {
+            CMediaDataBenchmark test;
+            retVal |= QTest::qExec( &test, argc, argv );
+        }
+        {
+            CMergedMediaBenchmark test;
+            retVal |= QTest::qExec( &test, argc, argv );
+        }
+        {
+            CSymbolBenchmark test;
+            retVal |= QTest::qExec( &test, argc, argv );
+        }
+        return retVal;
+    }
+
+    {
+        CMergeMediaTest test;
+        retVal |= QTest::qExec( &test, argc, argv );
+    }
+    {
+        CSparseUserDataTest test;
+        retVal |= QTest::qExec( &test, argc, argv );
+    }
+    {
+        CUserDataListenerTest test;
+        retVal |= QTest::qExec( &test, argc, argv );
+    }
+    return retVal;
+}
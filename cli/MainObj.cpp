@@ -31,13 +31,18 @@
 #include "Core/MediaModel.h"
 #include "Core/ServerModel.h"
 #include "Core/CollectionsModel.h"
+#include "Core/DeltaSyncState.h"
 #include "Core/MediaData.h"
+#include "Core/SyncPlan.h"
+#include "Core/UserDataListener.h"
 
 #include "SABUtils/QtUtils.h"
 #include "Version.h"
+#include <csignal>
 #include <iostream>
 
 #include <QTimer>
+#include <QTime>
 #include <QDateTime>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -85,49 +90,78 @@ CMainObj::CMainObj( const QString &settingsFile, const QString &mode, QObject *p
     }
 
     fUsersModel = std::make_shared< CUsersModel >( fSettings, fServerModel );
-    fMediaModel = std::make_shared< CMediaModel >( fSettings, fServerModel );
-    fCollectionsModel = std::make_shared< CCollectionsModel >( fMediaModel );
+    fEchoFilter = std::make_shared< CUserDataEchoFilter >();
+    fDeltaSyncState = std::make_shared< CDeltaSyncState >( fSettings->fileName() );
 
-    fSyncSystem = std::make_shared< CSyncSystem >( fSettings, fUsersModel, fMediaModel, fCollectionsModel, fServerModel );
+    fWorkers.push_back( createWorker() );
+    connect( fWorkers.front()->fSyncSystem.get(), &CSyncSystem::sigLoadingUsersFinished, this, &CMainObj::slotLoadingUsersFinished );
 
-    connect( fSyncSystem.get(), &CSyncSystem::sigAddToLog, this, &CMainObj::slotAddToLog );
-    connect( fSyncSystem.get(), &CSyncSystem::sigLoadingUsersFinished, this, &CMainObj::slotLoadingUsersFinished );
-    connect( fSyncSystem.get(), &CSyncSystem::sigUserMediaLoaded, this, &CMainObj::slotProcessMedia );
-    connect( fSyncSystem.get(), &CSyncSystem::sigMissingEpisodesLoaded, this, &CMainObj::slotMissingEpisodesLoaded );
+    fAOK = true;
+}
+
+std::shared_ptr< SSyncWorker > CMainObj::createWorker( bool poolWorker )
+{
+    auto worker = std::make_shared< SSyncWorker >();
+    auto rawWorker = worker.get();   // the worker owns the sync system, so the callbacks can not hold a reference to it
+
+    worker->fMediaModel = std::make_shared< CMediaModel >( fSettings, fServerModel );
+    worker->fCollectionsModel = std::make_shared< CCollectionsModel >( worker->fMediaModel );
 
-    connect( fSyncSystem.get(), &CSyncSystem::sigProcessingFinished, this, &CMainObj::slotProcessingFinished );
-    connect( fSyncSystem.get(), &CSyncSystem::sigUserMediaLoaded, this, &CMainObj::slotUserMediaCompletelyLoaded );
+    auto syncSystem = worker->fSyncSystem = std::make_shared< CSyncSystem >( fSettings, fUsersModel, worker->fMediaModel, worker->fCollectionsModel, fServerModel );
+    syncSystem->setDeltaSyncAllowed( true );
+    syncSystem->setSharedCatalog( fSettings->sharedCatalog() );
+    syncSystem->setEchoFilter( fEchoFilter );
+    syncSystem->setDeltaSyncState( fDeltaSyncState );
+
+    connect( syncSystem.get(), &CSyncSystem::sigAddToLog, this, [ this, rawWorker ]( int msgType, const QString &msg ) { addToLog( rawWorker, msgType, QString(), msg ); } );
+    if ( poolWorker )
+    {
+        connect( syncSystem.get(), &CSyncSystem::sigUserMediaLoaded, this, [ this, rawWorker ]() { processMedia( rawWorker ); } );
+        connect( syncSystem.get(), &CSyncSystem::sigMissingEpisodesLoaded, this, [ this, rawWorker ]() { missingEpisodesLoaded( rawWorker ); } );
+
+        connect( syncSystem.get(), &CSyncSystem::sigProcessingFinished, this, [ this, rawWorker ]( const QString &userName ) { processingFinished( rawWorker, userName ); } );
+        connect( syncSystem.get(), &CSyncSystem::sigUserMediaLoaded, this, [ this, rawWorker ]() { userMediaCompletelyLoaded( rawWorker ); } );
+    }
 
     auto progressSystem = std::make_shared< CProgressSystem >();
     progressSystem->setSetTitleFunc(
-        [ this ]( const QString &title )
+        [ this, rawWorker ]( const QString &title )
         {
-            fCurrentProgress = { 0, title, QString() };
-            addToLog( EMsgType::eInfo, std::get< 1 >( fCurrentProgress ) );
+            rawWorker->fCurrentProgress = { 0, title, QString() };
+            addToLog( rawWorker, EMsgType::eInfo, QString(), std::get< 1 >( rawWorker->fCurrentProgress ) );
         } );
     progressSystem->setIncFunc(
-        [ this ]()
+        [ rawWorker ]()
         {
-            std::get< 0 >( fCurrentProgress )++;
+            std::get< 0 >( rawWorker->fCurrentProgress )++;
             static constexpr auto chars = R"(|||///---***---\\\)";
             static auto cnt = strlen( chars );
-            auto value = std::get< 0 >( fCurrentProgress ) % cnt;
+            auto value = std::get< 0 >( rawWorker->fCurrentProgress ) % cnt;
             std::cout << chars[ value ] << '\b';
         } );
     progressSystem->setResetFunc(
-        [ this ]()
+        [ this, rawWorker ]()
         {
-            if ( std::get< 1 >( fCurrentProgress ) != std::get< 2 >( fCurrentProgress ) )
+            auto &&progress = rawWorker->fCurrentProgress;
+            if ( std::get< 1 >( progress ) != std::get< 2 >( progress ) )
             {
-                addToLog( EMsgType::eInfo, QString( "Finished '%1'" ).arg( std::get< 1 >( fCurrentProgress ) ) );
-                std::get< 2 >( fCurrentProgress ) = std::get< 1 >( fCurrentProgress );
+                addToLog( rawWorker, EMsgType::eInfo, QString(), QString( "Finished '%1'" ).arg( std::get< 1 >( progress ) ) );
+                std::get< 2 >( progress ) = std::get< 1 >( progress );
             }
         } );
 
-    fSyncSystem->setProgressSystem( progressSystem );
-    fSyncSystem->setUserMsgFunc( [ this ]( EMsgType msgType, const QString &title, QString msg ) { addToLog( msgType, title, msg ); } );
+    syncSystem->setProgressSystem( progressSystem );
+    syncSystem->setUserMsgFunc( [ this, rawWorker ]( EMsgType msgType, const QString &title, QString msg ) { addToLog( rawWorker, msgType, title, msg ); } );
+    return worker;
+}
 
-    fAOK = true;
+namespace
+{
+    volatile std::sig_atomic_t sStopRequested = 0;
+    void stopHandler( int )
+    {
+        sStopRequested = 1;
+    }
 }
 
 bool CMainObj::aOK() const
@@ -150,6 +184,18 @@ void CMainObj::addToLog( int msgType, const QString &msg )
     addToLog( msgType, QString(), msg );
 }
 
+// with more than one job the lines of different users are interleaved, so each is marked with its user
+void CMainObj::addToLog( SSyncWorker *worker, int msgType, const QString &title, const QString &msg )
+{
+    if ( msg.isEmpty() || ( fJobs <= 1 ) || !worker || !worker->fCurrUser )
+    {
+        addToLog( msgType, title, msg );
+        return;
+    }
+
+    addToLog( msgType, title, QString( "[%1] %2" ).arg( worker->fCurrUser->allNames() ).arg( msg ) );
+}
+
 void CMainObj::addToLog( int msgType, const QString &title, const QString &msg )
 {
     if ( fQuiet )
@@ -168,7 +214,7 @@ void CMainObj::addToLog( int msgType, const QString &title, const QString &msg )
 
 void CMainObj::run()
 {
-    if ( !fSettings || !fSyncSystem )
+    if ( !fSettings || fWorkers.empty() )
         return;
 
     if ( fMode == EMode::eCheckMissing )
@@ -181,7 +227,23 @@ void CMainObj::run()
         }
     }
 
-    fSyncSystem->loadUsers();
+    if ( fMode == EMode::eDaemon )
+    {
+        // the handler can only set a flag, it is picked up on the event loop
+        std::signal( SIGTERM, stopHandler );
+        std::signal( SIGINT, stopHandler );
+
+        fStopTimer = new QTimer( this );
+        fStopTimer->setInterval( 250 );
+        connect( fStopTimer, &QTimer::timeout, this, &CMainObj::checkForStop );
+        fStopTimer->start();
+
+        fCycleTimer = new QTimer( this );
+        fCycleTimer->setSingleShot( true );
+        connect( fCycleTimer, &QTimer::timeout, this, &CMainObj::startCycle );
+    }
+
+    fWorkers.front()->fSyncSystem->loadUsers();
 }
 
 void CMainObj::setMinimumDate( const QString &minDate )
@@ -206,7 +268,7 @@ void CMainObj::setMaximumDate( const QString &maxDate )
 
 void CMainObj::slotLoadingUsersFinished()
 {
-    if ( !fSyncSystem )
+    if ( fWorkers.empty() )
         return;
 
     fUsersToSync.clear();
@@ -236,7 +298,7 @@ void CMainObj::slotLoadingUsersFinished()
         return;
     }
 
-    if ( fMode == EMode::eSync )
+    if ( isSyncMode() )
     {
         std::map< QString, std::shared_ptr< CUserData > > unsyncable;
         for ( auto &&ii = fUsersToSync.begin(); ii != fUsersToSync.end(); )
@@ -268,63 +330,201 @@ void CMainObj::slotLoadingUsersFinished()
         return;
     }
 
-    QTimer::singleShot( 0, this, &CMainObj::slotProcessNextUser );
+    if ( fMode == EMode::eDaemon )
+        fDaemonUsers = fUsersToSync;
+    startCycle();
 }
 
-void CMainObj::slotProcessNextUser()
+void CMainObj::startCycle()
 {
-    if ( fUsersToSync.empty() )
+    if ( fMode == EMode::eDaemon )
     {
-        emit sigExit( 0 );
+        if ( fStopping )
+            return;
+
+        fUsersToSync = fDaemonUsers;
+        fUserTimes.clear();
+        fCycle++;
+
+        // later cycles only fetch user data against the catalog in memory, it is reloaded once it is CatalogRefreshMinutes old
+        // so added and removed media is picked up
+        auto refreshMinutes = fSettings->catalogRefreshMinutes();
+        if ( fCycle == 1 )
+            fCatalogTimer.start();
+        else if ( fSettings->sharedCatalog() && ( ( refreshMinutes <= 0 ) || ( fCatalogTimer.elapsed() >= ( refreshMinutes * 60LL * 1000 ) ) ) )
+        {
+            slotAddToLog( EMsgType::eInfo, QString( "Reloading the shared catalog, it was loaded %1 minutes ago" ).arg( fCatalogTimer.elapsed() / 60000 ) );
+            for ( auto &&ii : fWorkers )
+                ii->fSyncSystem->invalidateSharedCatalog();
+            fCatalogTimer.start();
+        }
+        slotAddToLog( EMsgType::eInfo, QString( "Starting sync cycle %1" ).arg( fCycle ) );
+        if ( fListen && !fLiveWorker )
+            startListening();
+    }
+
+    // each worker takes the next user from the list as it finishes one, only sync modes have more than one
+    auto numWorkers = isSyncMode() ? std::min( fJobs, static_cast< int >( fUsersToSync.size() ) ) : 1;
+    while ( static_cast< int >( fWorkers.size() ) < numWorkers )
+        fWorkers.push_back( createWorker() );
+    if ( numWorkers > 1 )
+        slotAddToLog( EMsgType::eInfo, QString( "Syncing %1 users, %2 at a time" ).arg( fUsersToSync.size() ).arg( numWorkers ) );
+
+    fRunTimer.start();
+    fWorkersRunning = numWorkers;
+    for ( int ii = 0; ii < numWorkers; ++ii )
+    {
+        auto worker = fWorkers[ ii ].get();
+        QTimer::singleShot( 0, this, [ this, worker ]() { processNextUser( worker ); } );
+    }
+}
+
+void CMainObj::processNextUser( SSyncWorker *worker )
+{
+    if ( worker->fCurrUser )
+    {
+        fUserTimes.emplace_back( worker->fCurrUser->allNames(), worker->fUserTimer.elapsed() );
+        worker->fCurrUser.reset();
+    }
+
+    if ( fUsersToSync.empty() || fStopping )
+    {
+        if ( --fWorkersRunning == 0 )
+            cycleFinished();
         return;
     }
 
     auto currUser = fUsersToSync.front();
     fUsersToSync.pop_front();
-    if ( fMode == EMode::eSync )
+    worker->fCurrUser = currUser;
+    worker->fUserTimer.start();
+    if ( isSyncMode() )
     {
-        slotAddToLog( EMsgType::eInfo, "Processing user: " + currUser->allNames() );
-        fSyncSystem->loadUsersMedia( ETool::ePlayState, currUser );
+        addToLog( worker, EMsgType::eInfo, QString(), "Processing user: " + currUser->allNames() );
+        worker->fSyncSystem->loadUsersMedia( ETool::ePlayState, currUser );
     }
     else if ( fMode == EMode::eCheckMissing )
     {
-        if ( !fSyncSystem->loadMissingEpisodes( currUser, fSelectedServer, fMinDate, fMaxDate ) )
+        if ( !worker->fSyncSystem->loadMissingEpisodes( currUser, fSelectedServer, fMinDate, fMaxDate ) )
         {
             fErrorString = tr( "No user found with Administrator Privileges on server '%1'" ).arg( fSelectedServer->displayName() );
         }
     }
 }
 
-void CMainObj::slotUserMediaCompletelyLoaded()
+void CMainObj::userMediaCompletelyLoaded( SSyncWorker *worker )
 {
-    if ( fMode == EMode::eSync )
-        slotAddToLog( EMsgType::eInfo, "Finished loading media information" );
+    if ( isSyncMode() )
+        addToLog( worker, EMsgType::eInfo, QString(), "Finished loading media information" );
 }
 
-void CMainObj::slotProcessingFinished( const QString &userName )
+void CMainObj::processingFinished( SSyncWorker *worker, const QString &userName )
 {
-    slotAddToLog( EMsgType::eInfo, QString( "Finished processing user '%1'" ).arg( userName ) );
-    QTimer::singleShot( 0, this, &CMainObj::slotProcessNextUser );
+    addToLog( worker, EMsgType::eInfo, QString(), QString( "Finished processing user '%1'" ).arg( userName ) );
+    QTimer::singleShot( 0, this, [ this, worker ]() { processNextUser( worker ); } );
 }
 
-void CMainObj::slotProcessMedia()
+void CMainObj::processMedia( SSyncWorker *worker )
 {
-    if ( fMode == EMode::eSync )
-        fSyncSystem->selectiveProcessMedia( fSelectedServerToProcess );
+    if ( !isSyncMode() )
+        return;
+
+    if ( !fDryRun )
+    {
+        worker->fSyncSystem->selectiveProcessMedia( fSelectedServerToProcess );
+        return;
+    }
+
+    auto plan = worker->fSyncSystem->buildSyncPlan( fSelectedServerToProcess );
+    QJsonDocument doc( plan.toJson() );
+    std::cout << doc.toJson( QJsonDocument::JsonFormat::Indented ).toStdString() << "\n";
+    QTimer::singleShot( 0, this, [ this, worker ]() { processNextUser( worker ); } );
 }
 
-void CMainObj::slotMissingEpisodesLoaded()
+void CMainObj::missingEpisodesLoaded( SSyncWorker *worker )
 {
-    slotAddToLog( EMsgType::eInfo, "Finished loading missing episodes" );
+    addToLog( worker, EMsgType::eInfo, QString(), "Finished loading missing episodes" );
     QJsonArray shows;
 
-    for ( auto &&mediaInfo : *fMediaModel )
+    for ( auto &&mediaInfo : *worker->fMediaModel )
     {
         shows.push_back( mediaInfo->toJson( true ) );
     }
     QJsonDocument doc( shows );
     std::cout << doc.toJson( QJsonDocument::JsonFormat::Indented ).toStdString() << "\n";
-    QTimer::singleShot( 0, this, &CMainObj::slotProcessNextUser );
+    QTimer::singleShot( 0, this, [ this, worker ]() { processNextUser( worker ); } );
+}
+
+void CMainObj::showSummary()
+{
+    if ( fUserTimes.empty() )
+        return;
+
+    auto timeString = []( qint64 msecs ) { return QTime::fromMSecsSinceStartOfDay( static_cast< int >( msecs % ( 24LL * 60 * 60 * 1000 ) ) ).toString( "hh:mm:ss.zzz" ); };
+
+    QStringList lines;
+    lines << QString( "Finished %1 users in %2 with %3 jobs" ).arg( fUserTimes.size() ).arg( timeString( fRunTimer.elapsed() ) ).arg( fJobs );
+    for ( auto &&ii : fUserTimes )
+        lines << QString( "\t%1 - %2" ).arg( ii.first ).arg( timeString( ii.second ) );
+    addToLog( EMsgType::eInfo, lines.join( "\n" ) );
+}
+
+void CMainObj::cycleFinished()
+{
+    showSummary();
+    if ( ( fMode != EMode::eDaemon ) || fStopping )
+    {
+        emit sigExit( 0 );
+        return;
+    }
+
+    // the interval runs from the start of the cycle, a cycle longer than the interval starts the next one right away
+    auto remaining = std::max( 0LL, static_cast< long long >( fIntervalMSecs ) - static_cast< long long >( fRunTimer.elapsed() ) );
+    slotAddToLog( EMsgType::eInfo, QString( "Next sync cycle in %1 seconds" ).arg( remaining / 1000 ) );
+    fCycleTimer->start( static_cast< int >( remaining ) );
+}
+
+void CMainObj::checkForStop()
+{
+    if ( !sStopRequested || fStopping )
+        return;
+
+    fStopping = true;
+    fCycleTimer->stop();
+    if ( fListener )
+        fListener->stop();
+    if ( fWorkersRunning == 0 )
+    {
+        slotAddToLog( EMsgType::eInfo, "Stop requested, exiting" );
+        emit sigExit( 0 );
+        return;
+    }
+    slotAddToLog( EMsgType::eInfo, "Stop requested, exiting once the users being synced are finished" );
+}
+
+void CMainObj::startListening()
+{
+    // The live worker loads its own catalog once, media added later is picked up by the sync cycles.
+    // It is loaded for the first daemon user only, one full media list per server, loading it for every user
+    // would repeat that for each of them.  Each change reloads the other servers for the user of the event,
+    // so only the media IDs are used from it, a change to media the first user can not see is logged and left to the next cycle
+    fLiveWorker = createWorker( false );
+    auto syncSystem = fLiveWorker->fSyncSystem.get();
+    connect(
+        syncSystem, &CSyncSystem::sigUserMediaLoaded, this,
+        [ this, syncSystem ]()
+        {
+            if ( fListener || fStopping )
+                return;
+
+            fListener = new CUserDataListener( fServerModel, this );
+            connect( fListener, &CUserDataListener::sigAddToLog, this, &CMainObj::slotAddToLog );
+            connect( fListener, &CUserDataListener::sigUserDataChanged, syncSystem, &CSyncSystem::syncUserDataChange );
+            fListener->start();
+        } );
+
+    slotAddToLog( EMsgType::eInfo, "Loading the media catalog for play state change events" );
+    syncSystem->loadUsersMedia( ETool::ePlayState, fDaemonUsers.front() );
 }
 
 bool CMainObj::setMode( const QString &mode )
@@ -333,6 +533,8 @@ bool CMainObj::setMode( const QString &mode )
         fMode = EMode::eCheckMissing;
     else if ( mode == "sync" )
         fMode = EMode::eSync;
+    else if ( mode == "daemon" )
+        fMode = EMode::eDaemon;
     else
     {
         fErrorString = QString( "Invalid mode '%1'" ).arg( mode );
@@ -25,12 +25,19 @@
 
 #include <QObject>
 #include <QDate>
+#include <QElapsedTimer>
 #include <QRegularExpression>
+#include <algorithm>
 #include <list>
 #include <memory>
 #include <tuple>
+#include <vector>
 
+class QTimer;
 class CSettings;
+class CUserDataListener;
+class CUserDataEchoFilter;
+class CDeltaSyncState;
 class CSyncSystem;
 class CUserData;
 class CMediaModel;
@@ -38,6 +45,19 @@ class CUsersModel;
 class CServerModel;
 class CCollectionsModel;
 class CServerInfo;
+
+// one user at a time is synced through each worker, every worker has its own media catalog and requests
+struct SSyncWorker
+{
+    std::shared_ptr< CMediaModel > fMediaModel;
+    std::shared_ptr< CCollectionsModel > fCollectionsModel;
+    std::shared_ptr< CSyncSystem > fSyncSystem;
+
+    std::shared_ptr< CUserData > fCurrUser;
+    QElapsedTimer fUserTimer;
+    std::tuple< int, QString, QString > fCurrentProgress{ 0, QString(), QString() };
+};
+
 class CMainObj : public QObject
 {
     Q_OBJECT;
@@ -47,7 +67,8 @@ public:
     {
         eUnknown,
         eCheckMissing,
-        eSync
+        eSync,
+        eDaemon   // sync, then resync every interval until SIGTERM
     };
 
     CMainObj( const QString &settingsFile, const QString &mode, QObject *parent = nullptr );
@@ -64,6 +85,10 @@ public:
     QString errorString() const { return fErrorString; }
 
     void setQuiet( bool quiet ) { fQuiet = quiet; }
+    void setDryRun( bool dryRun ) { fDryRun = dryRun; }
+    void setJobs( int jobs ) { fJobs = std::max( 1, jobs ); }   // users synced at the same time
+    void setInterval( int minutes ) { fIntervalMSecs = std::max( 1, minutes ) * 60 * 1000; }   // daemon mode only
+    void setListen( bool listen ) { fListen = listen; }   // daemon mode only, syncs play state changes as the servers report them
     void addToLog( int msgType, const QString &title, const QString &msg );
     void addToLog( int msgType, const QString &msg );
 
@@ -72,30 +97,39 @@ Q_SIGNALS:
 public Q_SLOTS:
     void slotAddToLog( int msgType, const QString &msg );
     void slotLoadingUsersFinished();
-    void slotProcessNextUser();
-    void slotUserMediaCompletelyLoaded();
-    void slotProcessingFinished( const QString &userName );
-    void slotMissingEpisodesLoaded();
-    void slotProcessMedia();
 
 private:
     bool setMode( const QString &mode );
-    std::shared_ptr< CSettings > fSettings;
-    std::shared_ptr< CSyncSystem > fSyncSystem;
+    bool isSyncMode() const { return ( fMode == EMode::eSync ) || ( fMode == EMode::eDaemon ); }
+    std::shared_ptr< SSyncWorker > createWorker( bool poolWorker = true );
+    void addToLog( SSyncWorker *worker, int msgType, const QString &title, const QString &msg );
+
+    void processNextUser( SSyncWorker *worker );
+    void userMediaCompletelyLoaded( SSyncWorker *worker );
+    void processingFinished( SSyncWorker *worker, const QString &userName );
+    void missingEpisodesLoaded( SSyncWorker *worker );
+    void processMedia( SSyncWorker *worker );
+    void showSummary();
+
+    void startCycle();
+    void cycleFinished();
+    void checkForStop();
+    void startListening();
 
+    std::shared_ptr< CSettings > fSettings;
     std::shared_ptr< CServerModel > fServerModel;
-    std::shared_ptr< CMediaModel > fMediaModel;
-    std::shared_ptr< CCollectionsModel > fCollectionsModel;
     std::shared_ptr< CUsersModel > fUsersModel;
+    std::vector< std::shared_ptr< SSyncWorker > > fWorkers;   // the first one also loads the users
+    int fWorkersRunning{ 0 };
 
     QString fSettingsFile;
     QRegularExpression fUserRegExp;
     mutable QString fErrorString{ "Unknown Error" };
     mutable bool fAOK{ false };
 
-    std::tuple< int, QString, QString > fCurrentProgress{ 0, QString(), QString() };
-
     std::list< std::shared_ptr< CUserData > > fUsersToSync;
+    std::list< std::pair< QString, qint64 > > fUserTimes;   // user -> wall time in msecs, in the order they finished
+    QElapsedTimer fRunTimer;
     QString fSelectedServerToProcess;
     std::shared_ptr< CServerInfo > fSelectedServer;
 
@@ -103,6 +137,22 @@ private:
     QDate fMaxDate;
     EMode fMode{ EMode::eUnknown };
     bool fQuiet{ false };
+    bool fDryRun{ false };
+    int fJobs{ 1 };
+
+    std::list< std::shared_ptr< CUserData > > fDaemonUsers;   // re-queued at the start of every cycle
+    QTimer *fCycleTimer{ nullptr };
+    QTimer *fStopTimer{ nullptr };
+    int fIntervalMSecs{ 15 * 60 * 1000 };
+    int fCycle{ 0 };
+    QElapsedTimer fCatalogTimer;   // time since the shared catalog was last loaded
+    bool fStopping{ false };
+
+    bool fListen{ false };
+    std::shared_ptr< SSyncWorker > fLiveWorker;   // not part of the pool, only runs the changes the listener reports
+    CUserDataListener *fListener{ nullptr };
+    std::shared_ptr< CUserDataEchoFilter > fEchoFilter;   // the writes of every worker, their events are not synced again
+    std::shared_ptr< CDeltaSyncState > fDeltaSyncState;   // one set of watermarks for every worker, loaded once and kept for the daemon's cycles
 };
 
 #endif
\ No newline at end of file
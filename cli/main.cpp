@@ -51,7 +51,7 @@ int main( int argc, char **argv )
     auto modeOption = QCommandLineOption(
         QStringList() << "mode"
                       << "m",
-        "The particular mode of operation you wish to use valid values are check_missing|sync", "Mode" );
+        "The particular mode of operation you wish to use valid values are check_missing|sync|daemon", "Mode" );
     parser.addOption( modeOption );
 
     auto selectedServerOption = QCommandLineOption( QStringList() << "selected_server", "The server name you wish to use as the primary server to use as the source server (required for check_missing)", "Selected Server" );
@@ -70,6 +70,22 @@ int main( int argc, char **argv )
         QString( "Minimize text output" ), "" );
     parser.addOption( quietOption );
 
+    auto dryRunOption = QCommandLineOption( QStringList() << "dry_run"
+                                                          << "dry-run",
+                                            QString( "Print the changes a sync would make as json, without making them" ) );
+    parser.addOption( dryRunOption );
+
+    auto jobsOption = QCommandLineOption( QStringList() << "jobs"
+                                                        << "j",
+                                          QString( "The number of users to sync at the same time (default 1)" ), "jobs", "1" );
+    parser.addOption( jobsOption );
+
+    auto intervalOption = QCommandLineOption( QStringList() << "interval", QString( "The number of minutes between sync cycles in daemon mode (default 15)" ), "minutes", "15" );
+    parser.addOption( intervalOption );
+
+    auto listenOption = QCommandLineOption( QStringList() << "listen", QString( "In daemon mode, also sync play state changes as soon as the servers report them" ) );
+    parser.addOption( listenOption );
+
     parser.process( appl );
 
     if ( !parser.unknownOptionNames().isEmpty() )
@@ -123,6 +139,25 @@ int main( int argc, char **argv )
     mainObj->setMinimumDate( parser.value( minDateOption ) );
     mainObj->setMaximumDate( parser.value( maxDateOption ) );
     mainObj->setQuiet( parser.isSet( quietOption ) );
+    mainObj->setDryRun( parser.isSet( dryRunOption ) );
+
+    bool aOK = false;
+    auto jobs = parser.value( jobsOption ).toInt( &aOK );
+    if ( !aOK || ( jobs < 1 ) )
+    {
+        std::cerr << "--jobs must be a number greater than 0\n";
+        return -1;
+    }
+    mainObj->setJobs( jobs );
+
+    auto interval = parser.value( intervalOption ).toInt( &aOK );
+    if ( !aOK || ( interval < 1 ) )
+    {
+        std::cerr << "--interval must be a number greater than 0\n";
+        return -1;
+    }
+    mainObj->setInterval( interval );
+    mainObj->setListen( parser.isSet( listenOption ) );
     if ( !mainObj->aOK() )
     {
         std::cerr << mainObj->errorString().toStdString() << "\n";